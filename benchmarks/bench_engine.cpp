@@ -0,0 +1,170 @@
+#include "bench_helper.hpp"
+#include "ml_kem/ml_kem_768_engine.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <cassert>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Number of items in each job, submitted to the engine. Large enough, s.t. each of 64 workers gets 8 chunks of its own to begin with.
+constexpr size_t ENGINE_BATCH_SIZE = 4096;
+
+// Registers the benchmark for 1, 2, 4, ... worker threads, up to the number of concurrent threads supported by the hardware.
+void
+worker_counts(benchmark::internal::Benchmark* bench)
+{
+  const int64_t max_workers = std::max<int64_t>(std::thread::hardware_concurrency(), 1);
+
+  for (int64_t workers = 1; workers < max_workers; workers *= 2) {
+    bench->Arg(workers);
+  }
+  bench->Arg(max_workers);
+}
+
+// Benchmarking scaling of ML-KEM-768 key generation jobs, run by an engine with `state.range(0)` -many worker threads. Throughput is
+// reported per keypair, in wall-clock time.
+void
+bench_ml_kem_768_engine_keygen(benchmark::State& state)
+{
+  ml_kem_768::engine eng{ static_cast<size_t>(state.range(0)) };
+
+  std::vector<ml_kem_768::seed_pair_t> seeds(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::seckey_t> seckeys(ENGINE_BATCH_SIZE);
+
+  randomshake::randomshake_t csprng{};
+
+  for (auto& seed : seeds) {
+    csprng.generate(seed.d);
+    csprng.generate(seed.z);
+  }
+
+  bool is_generated = true;
+  for (auto _ : state) {
+    is_generated &= ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys).get();
+
+    benchmark::DoNotOptimize(is_generated);
+    benchmark::DoNotOptimize(seeds.data());
+    benchmark::DoNotOptimize(pubkeys.data());
+    benchmark::DoNotOptimize(seckeys.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_generated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ENGINE_BATCH_SIZE));
+}
+
+// Benchmarking scaling of ML-KEM-768 encapsulation jobs, each encapsulating to distinct public keys, run by an engine with
+// `state.range(0)` -many worker threads. Throughput is reported per encapsulation, in wall-clock time.
+void
+bench_ml_kem_768_engine_encapsulate(benchmark::State& state)
+{
+  ml_kem_768::engine eng{ static_cast<size_t>(state.range(0)) };
+
+  std::vector<ml_kem_768::seed_pair_t> seeds(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::seckey_t> seckeys(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::seed_m_t> ms(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::cipher_text_t> ciphers(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(ENGINE_BATCH_SIZE);
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ENGINE_BATCH_SIZE; i++) {
+    csprng.generate(seeds[i].d);
+    csprng.generate(seeds[i].z);
+    csprng.generate(ms[i]);
+  }
+
+  const bool is_generated = ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys).get();
+  assert(is_generated);
+  (void)is_generated;
+
+  bool is_encapsulated = true;
+  for (auto _ : state) {
+    const auto is_valid = ml_kem_768::encapsulate_batch(eng, ms, pubkeys, ciphers, shared_secrets).get();
+    is_encapsulated &= std::all_of(is_valid.begin(), is_valid.end(), [](const bool flag) { return flag; });
+
+    benchmark::DoNotOptimize(is_encapsulated);
+    benchmark::DoNotOptimize(ms.data());
+    benchmark::DoNotOptimize(pubkeys.data());
+    benchmark::DoNotOptimize(ciphers.data());
+    benchmark::DoNotOptimize(shared_secrets.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_encapsulated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ENGINE_BATCH_SIZE));
+}
+
+// Benchmarking scaling of ML-KEM-768 decapsulation jobs, each decapsulating cipher texts under one prepared secret key, run by an engine
+// with `state.range(0)` -many worker threads. Throughput is reported per decapsulation, in wall-clock time.
+void
+bench_ml_kem_768_engine_decapsulate(benchmark::State& state)
+{
+  ml_kem_768::engine eng{ static_cast<size_t>(state.range(0)) };
+
+  ml_kem_768::seed_pair_t seed{};
+  ml_kem_768::pubkey_t pubkey{};
+  ml_kem_768::seckey_t seckey{};
+
+  std::vector<ml_kem_768::seed_m_t> ms(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::cipher_text_t> ciphers(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets_sender(ENGINE_BATCH_SIZE);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets_receiver(ENGINE_BATCH_SIZE);
+
+  auto prepared = std::make_unique<ml_kem_768::prepared_seckey>();
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed.d);
+  csprng.generate(seed.z);
+  ml_kem_768::keygen(seed.d, seed.z, pubkey, seckey);
+
+  const bool is_prepared = ml_kem_768::prepare_seckey(seckey, *prepared);
+  assert(is_prepared);
+  (void)is_prepared;
+
+  for (size_t i = 0; i < ENGINE_BATCH_SIZE; i++) {
+    csprng.generate(ms[i]);
+    (void)ml_kem_768::encapsulate(ms[i], pubkey, ciphers[i], shared_secrets_sender[i]);
+  }
+
+  bool is_decapsulated = true;
+  for (auto _ : state) {
+    is_decapsulated &= ml_kem_768::decapsulate_batch(eng, *prepared, ciphers, shared_secrets_receiver).get();
+
+    benchmark::DoNotOptimize(is_decapsulated);
+    benchmark::DoNotOptimize(ciphers.data());
+    benchmark::DoNotOptimize(shared_secrets_receiver.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_decapsulated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(ENGINE_BATCH_SIZE));
+  assert(shared_secrets_sender == shared_secrets_receiver);
+}
+
+BENCHMARK(bench_ml_kem_768_engine_keygen)
+  ->Name("ml_kem_768/engine_keygen")
+  ->ArgName("workers")
+  ->Apply(worker_counts)
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_768_engine_encapsulate)
+  ->Name("ml_kem_768/engine_encap")
+  ->ArgName("workers")
+  ->Apply(worker_counts)
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_768_engine_decapsulate)
+  ->Name("ml_kem_768/engine_decap")
+  ->ArgName("workers")
+  ->Apply(worker_counts)
+  ->UseRealTime()
+  ->ComputeStatistics("min", compute_min)
+  ->ComputeStatistics("max", compute_max);
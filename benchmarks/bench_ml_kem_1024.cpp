@@ -1,7 +1,10 @@
 #include "bench_helper.hpp"
 #include "ml_kem/ml_kem_1024.hpp"
+#include <algorithm>
 #include <benchmark/benchmark.h>
 #include <cassert>
+#include <memory>
+#include <vector>
 
 // Benchmarking ML-KEM-1024 key generation algorithm.
 void
@@ -31,6 +34,41 @@ bench_ml_kem_1024_keygen(benchmark::State& state)
   state.SetItemsProcessed(state.iterations());
 }
 
+// Benchmarking ML-KEM-1024 batched key generation algorithm, generating a batch of 64 keypairs per call, using a batch workspace, which
+// is reused across calls. Throughput is reported per keypair.
+void
+bench_ml_kem_1024_keygen_batch(benchmark::State& state)
+{
+  constexpr size_t BATCH_SIZE = 64;
+
+  std::vector<ml_kem_1024::seed_pair_t> seeds(BATCH_SIZE);
+  std::vector<ml_kem_1024::pubkey_t> pubkeys(BATCH_SIZE);
+  std::vector<ml_kem_1024::seckey_t> seckeys(BATCH_SIZE);
+
+  auto ws = std::make_unique<ml_kem_1024::batch_workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  for (auto& seed : seeds) {
+    csprng.generate(seed.d);
+    csprng.generate(seed.z);
+  }
+
+  bool is_generated = true;
+  for (auto _ : state) {
+    is_generated &= ml_kem_1024::keygen_batch(seeds, pubkeys, seckeys, *ws);
+
+    benchmark::DoNotOptimize(is_generated);
+    benchmark::DoNotOptimize(seeds.data());
+    benchmark::DoNotOptimize(pubkeys.data());
+    benchmark::DoNotOptimize(seckeys.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_generated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+}
+
 // Benchmarking ML-KEM-1024 encapsulation algorithm.
 void
 bench_ml_kem_1024_encapsulate(benchmark::State& state)
@@ -69,6 +107,132 @@ bench_ml_kem_1024_encapsulate(benchmark::State& state)
   state.SetItemsProcessed(state.iterations());
 }
 
+// Benchmarking ML-KEM-1024 encapsulation algorithm, using a caller-supplied workspace, which is reused across calls.
+void
+bench_ml_kem_1024_encapsulate_workspace(benchmark::State& state)
+{
+  std::array<uint8_t, ml_kem_1024::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_1024::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_1024::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_1024::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_1024::SKEY_BYTE_LEN> seckey{};
+
+  std::array<uint8_t, ml_kem_1024::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret{};
+
+  auto ws = std::make_unique<ml_kem_1024::workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  ml_kem_1024::keygen(seed_d, seed_z, pubkey, seckey);
+
+  bool is_encapsulated = true;
+  for (auto _ : state) {
+    is_encapsulated &= ml_kem_1024::encapsulate(seed_m, pubkey, cipher, shared_secret, *ws);
+
+    benchmark::DoNotOptimize(is_encapsulated);
+    benchmark::DoNotOptimize(seed_m);
+    benchmark::DoNotOptimize(pubkey);
+    benchmark::DoNotOptimize(cipher);
+    benchmark::DoNotOptimize(shared_secret);
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_encapsulated);
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmarking ML-KEM-1024 encapsulation algorithm, to a public key which is prepared only once.
+void
+bench_ml_kem_1024_encapsulate_prepared(benchmark::State& state)
+{
+  std::array<uint8_t, ml_kem_1024::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_1024::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_1024::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_1024::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_1024::SKEY_BYTE_LEN> seckey{};
+
+  std::array<uint8_t, ml_kem_1024::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret{};
+
+  ml_kem_1024::prepared_pubkey prepared{};
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  ml_kem_1024::keygen(seed_d, seed_z, pubkey, seckey);
+
+  const bool is_prepared = ml_kem_1024::prepare_pubkey(pubkey, prepared);
+  assert(is_prepared);
+  (void)is_prepared;
+
+  for (auto _ : state) {
+    ml_kem_1024::encapsulate(seed_m, prepared, cipher, shared_secret);
+
+    benchmark::DoNotOptimize(seed_m);
+    benchmark::DoNotOptimize(prepared);
+    benchmark::DoNotOptimize(cipher);
+    benchmark::DoNotOptimize(shared_secret);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+
+// Benchmarking ML-KEM-1024 batched encapsulation algorithm, encapsulating to a batch of 64 distinct public keys per call, using a batch
+// workspace, which is reused across calls. Throughput is reported per encapsulation.
+void
+bench_ml_kem_1024_encapsulate_batch(benchmark::State& state)
+{
+  constexpr size_t BATCH_SIZE = 64;
+
+  std::vector<ml_kem_1024::seed_pair_t> seeds(BATCH_SIZE);
+  std::vector<ml_kem_1024::pubkey_t> pubkeys(BATCH_SIZE);
+  std::vector<ml_kem_1024::seckey_t> seckeys(BATCH_SIZE);
+  std::vector<ml_kem_1024::seed_m_t> ms(BATCH_SIZE);
+  std::vector<ml_kem_1024::cipher_text_t> ciphers(BATCH_SIZE);
+  std::vector<ml_kem_1024::shared_secret_t> shared_secrets(BATCH_SIZE);
+
+  auto ws = std::make_unique<ml_kem_1024::batch_workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < BATCH_SIZE; i++) {
+    csprng.generate(seeds[i].d);
+    csprng.generate(seeds[i].z);
+    csprng.generate(ms[i]);
+  }
+
+  const bool is_generated = ml_kem_1024::keygen_batch(seeds, pubkeys, seckeys, *ws);
+  assert(is_generated);
+  (void)is_generated;
+
+  bool is_encapsulated = true;
+  for (auto _ : state) {
+    const auto is_valid = ml_kem_1024::encapsulate_batch(ms, pubkeys, ciphers, shared_secrets, *ws);
+    is_encapsulated &= std::all_of(is_valid.begin(), is_valid.end(), [](const bool flag) { return flag; });
+
+    benchmark::DoNotOptimize(is_encapsulated);
+    benchmark::DoNotOptimize(ms.data());
+    benchmark::DoNotOptimize(pubkeys.data());
+    benchmark::DoNotOptimize(ciphers.data());
+    benchmark::DoNotOptimize(shared_secrets.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_encapsulated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+}
+
 // Benchmarking ML-KEM-1024 decapsulation algorithm.
 void
 bench_ml_kem_1024_decapsulate(benchmark::State& state)
@@ -106,6 +270,196 @@ bench_ml_kem_1024_decapsulate(benchmark::State& state)
   assert(shared_secret_sender == shared_secret_receiver);
 }
 
+// Benchmarking ML-KEM-1024 decapsulation algorithm, using a caller-supplied workspace, which is reused across calls.
+void
+bench_ml_kem_1024_decapsulate_workspace(benchmark::State& state)
+{
+  std::array<uint8_t, ml_kem_1024::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_1024::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_1024::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_1024::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_1024::SKEY_BYTE_LEN> seckey{};
+
+  std::array<uint8_t, ml_kem_1024::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+
+  auto ws = std::make_unique<ml_kem_1024::workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  ml_kem_1024::keygen(seed_d, seed_z, pubkey, seckey);
+  (void)ml_kem_1024::encapsulate(seed_m, pubkey, cipher, shared_secret_sender);
+
+  for (auto _ : state) {
+    ml_kem_1024::decapsulate(seckey, cipher, shared_secret_receiver, *ws);
+
+    benchmark::DoNotOptimize(seckey);
+    benchmark::DoNotOptimize(cipher);
+    benchmark::DoNotOptimize(shared_secret_receiver);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  assert(shared_secret_sender == shared_secret_receiver);
+}
+
+// Benchmarking ML-KEM-1024 decapsulation algorithm, using a secret key which is prepared only once.
+void
+bench_ml_kem_1024_decapsulate_prepared(benchmark::State& state)
+{
+  std::array<uint8_t, ml_kem_1024::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_1024::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_1024::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_1024::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_1024::SKEY_BYTE_LEN> seckey{};
+
+  std::array<uint8_t, ml_kem_1024::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, ml_kem_1024::SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+
+  ml_kem_1024::prepared_seckey prepared{};
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  ml_kem_1024::keygen(seed_d, seed_z, pubkey, seckey);
+  (void)ml_kem_1024::encapsulate(seed_m, pubkey, cipher, shared_secret_sender);
+
+  const bool is_prepared = ml_kem_1024::prepare_seckey(seckey, prepared);
+  assert(is_prepared);
+  (void)is_prepared;
+
+  for (auto _ : state) {
+    ml_kem_1024::decapsulate(prepared, cipher, shared_secret_receiver);
+
+    benchmark::DoNotOptimize(prepared);
+    benchmark::DoNotOptimize(cipher);
+    benchmark::DoNotOptimize(shared_secret_receiver);
+    benchmark::ClobberMemory();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+  assert(shared_secret_sender == shared_secret_receiver);
+}
+
+// Benchmarking ML-KEM-1024 batched decapsulation algorithm, decapsulating a batch of 64 cipher texts, all encapsulated to same public key,
+// per call, using a batch workspace, which is reused across calls. Throughput is reported per decapsulation.
+void
+bench_ml_kem_1024_decapsulate_batch(benchmark::State& state)
+{
+  constexpr size_t BATCH_SIZE = 64;
+
+  std::array<uint8_t, ml_kem_1024::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_1024::SEED_Z_BYTE_LEN> seed_z{};
+
+  ml_kem_1024::pubkey_t pubkey{};
+  ml_kem_1024::seckey_t seckey{};
+
+  std::vector<ml_kem_1024::seed_m_t> ms(BATCH_SIZE);
+  std::vector<ml_kem_1024::cipher_text_t> ciphers(BATCH_SIZE);
+  std::vector<ml_kem_1024::shared_secret_t> shared_secrets_sender(BATCH_SIZE);
+  std::vector<ml_kem_1024::shared_secret_t> shared_secrets_receiver(BATCH_SIZE);
+
+  auto ws = std::make_unique<ml_kem_1024::batch_workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+
+  ml_kem_1024::keygen(seed_d, seed_z, pubkey, seckey);
+
+  for (size_t i = 0; i < BATCH_SIZE; i++) {
+    csprng.generate(ms[i]);
+    (void)ml_kem_1024::encapsulate(ms[i], pubkey, ciphers[i], shared_secrets_sender[i]);
+  }
+
+  bool is_decapsulated = true;
+  for (auto _ : state) {
+    is_decapsulated &= ml_kem_1024::decapsulate_batch(seckey, ciphers, shared_secrets_receiver, *ws);
+
+    benchmark::DoNotOptimize(is_decapsulated);
+    benchmark::DoNotOptimize(seckey);
+    benchmark::DoNotOptimize(ciphers.data());
+    benchmark::DoNotOptimize(shared_secrets_receiver.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_decapsulated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+  assert(shared_secrets_sender == shared_secrets_receiver);
+}
+
+// Benchmarking ML-KEM-1024 trial decapsulation algorithm, decapsulating a cipher text under a set of 64 prepared secret keys per call,
+// using a batch workspace, which is reused across calls. Throughput is reported per secret key tried.
+void
+bench_ml_kem_1024_decapsulate_many_keys(benchmark::State& state)
+{
+  constexpr size_t BATCH_SIZE = 64;
+
+  std::vector<ml_kem_1024::seed_pair_t> seeds(BATCH_SIZE);
+  std::vector<ml_kem_1024::pubkey_t> pubkeys(BATCH_SIZE);
+  std::vector<ml_kem_1024::seckey_t> seckeys(BATCH_SIZE);
+  std::vector<ml_kem_1024::prepared_seckey> prepared(BATCH_SIZE);
+  std::vector<ml_kem_1024::shared_secret_t> shared_secrets(BATCH_SIZE);
+
+  ml_kem_1024::seed_m_t seed_m{};
+  ml_kem_1024::cipher_text_t cipher{};
+  ml_kem_1024::shared_secret_t shared_secret_sender{};
+
+  auto ws = std::make_unique<ml_kem_1024::batch_workspace>();
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < BATCH_SIZE; i++) {
+    csprng.generate(seeds[i].d);
+    csprng.generate(seeds[i].z);
+  }
+  csprng.generate(seed_m);
+
+  bool is_prepared = ml_kem_1024::keygen_batch(seeds, pubkeys, seckeys, *ws);
+  for (size_t i = 0; i < BATCH_SIZE; i++) {
+    is_prepared &= ml_kem_1024::prepare_seckey(seckeys[i], prepared[i]);
+  }
+  assert(is_prepared);
+  (void)is_prepared;
+
+  (void)ml_kem_1024::encapsulate(seed_m, pubkeys[BATCH_SIZE / 2], cipher, shared_secret_sender);
+
+  bool is_decapsulated = true;
+  for (auto _ : state) {
+    is_decapsulated &= ml_kem_1024::decapsulate_many_keys(prepared, cipher, shared_secrets, *ws);
+
+    benchmark::DoNotOptimize(is_decapsulated);
+    benchmark::DoNotOptimize(prepared.data());
+    benchmark::DoNotOptimize(cipher);
+    benchmark::DoNotOptimize(shared_secrets.data());
+    benchmark::ClobberMemory();
+  }
+
+  assert(is_decapsulated);
+  state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(BATCH_SIZE));
+  assert(shared_secrets[BATCH_SIZE / 2] == shared_secret_sender);
+}
+
 BENCHMARK(bench_ml_kem_1024_keygen)->Name("ml_kem_1024/keygen")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_keygen_batch)->Name("ml_kem_1024/keygen_batch")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_ml_kem_1024_encapsulate)->Name("ml_kem_1024/encap")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_encapsulate_workspace)->Name("ml_kem_1024/encap_workspace")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_encapsulate_prepared)->Name("ml_kem_1024/encap_prepared")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_encapsulate_batch)->Name("ml_kem_1024/encap_batch")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
 BENCHMARK(bench_ml_kem_1024_decapsulate)->Name("ml_kem_1024/decap")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_decapsulate_workspace)->Name("ml_kem_1024/decap_workspace")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_decapsulate_prepared)->Name("ml_kem_1024/decap_prepared")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_decapsulate_batch)->Name("ml_kem_1024/decap_batch")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
+BENCHMARK(bench_ml_kem_1024_decapsulate_many_keys)->Name("ml_kem_1024/decap_many_keys")->ComputeStatistics("min", compute_min)->ComputeStatistics("max", compute_max);
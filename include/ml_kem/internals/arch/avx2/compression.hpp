@@ -0,0 +1,84 @@
+#pragma once
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include "ml_kem/internals/arch/avx2/ntt.hpp"
+#include "ml_kem/internals/arch/avx2/serialize.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// AVX2 implementation of (de)compression of polynomials with signed 16 -bit coefficients, fused with their (de)serialization, for each
+// d ∈ {1, 4, 5, 10, 11}, s.t. compressed coefficients never make a round trip through memory.
+namespace ml_kem_utils::avx2 {
+
+// Given 16 coefficients, each ∈ [0, q), this routine compresses them, computing round((2^d / q) * x) mod 2^d, same as portable `compress<d>`.
+//
+// Quotient ⌊((x << d) + ⌊q/2⌋) / q⌋ is first estimated using a 16 -bit fixed-point reciprocal of q, which may fall short of the exact
+// quotient by 1, which is detected by looking at the remainder, computed modulo 2^16, as it is known to be ∈ [0, 2q).
+template<size_t d>
+ML_KEM_TARGET_AVX2 inline __m256i
+compress(const __m256i x)
+{
+  constexpr auto recip = static_cast<int16_t>(static_cast<uint16_t>(((1U << (16 + d)) + (ml_kem_ntt::avx2::Q / 2)) / ml_kem_ntt::avx2::Q));
+
+  const __m256i q = _mm256_set1_epi16(ml_kem_ntt::avx2::Q);
+  const __m256i half_q = _mm256_set1_epi16(ml_kem_ntt::avx2::Q / 2);
+  const __m256i mask = _mm256_set1_epi16(static_cast<int16_t>((1U << d) - 1U));
+
+  const __m256i est = _mm256_mulhi_epu16(x, _mm256_set1_epi16(recip));
+  const __m256i rem = _mm256_sub_epi16(_mm256_add_epi16(_mm256_slli_epi16(x, d), half_q), _mm256_mullo_epi16(est, q));
+  const __m256i carry = _mm256_cmpgt_epi16(rem, _mm256_set1_epi16(ml_kem_ntt::avx2::Q - 1));
+
+  return _mm256_and_si256(_mm256_sub_epi16(est, carry), mask);
+}
+
+// Given 16 coefficients, each ∈ [0, 2^d), this routine decompresses them, computing ⌊(q * x + 2^(d-1)) / 2^d⌋, same as portable
+// `decompress<d>`, using a single rounding high multiplication.
+template<size_t d>
+ML_KEM_TARGET_AVX2 inline __m256i
+decompress(const __m256i x)
+{
+  return _mm256_mulhrs_epi16(_mm256_slli_epi16(x, 15 - static_cast<int>(d)), _mm256_set1_epi16(ml_kem_ntt::avx2::Q));
+}
+
+// Fully reduces each, possibly lazily reduced, coefficient and compresses it to d bits.
+template<size_t d>
+struct compress_map_t
+{
+  ML_KEM_TARGET_AVX2 static __m256i apply(const __m256i a)
+  {
+    return compress<d>(ml_kem_ntt::avx2::canonicalize(ml_kem_ntt::avx2::barrett_reduce(a)));
+  }
+};
+
+// Decompresses each decoded d -bit coefficient.
+template<size_t d>
+struct decompress_map_t
+{
+  ML_KEM_TARGET_AVX2 static __m256i apply(const __m256i a) { return decompress<d>(a); }
+};
+
+// Given a degree-255 polynomial with signed 16 -bit coefficients, this routine compresses and serializes it to a byte array of length
+// 32 * d -bytes, in a single pass, producing same bytes as the portable `compress_encode<d>` does.
+template<size_t d>
+ML_KEM_TARGET_AVX2 inline void
+compress_encode(std::span<const int16_t, ml_kem_ntt::N> poly, std::span<uint8_t, 32 * d> arr)
+{
+  encode_mapped<d, compress_map_t<d>>(poly, arr);
+}
+
+// Given a byte array of length 32 * d -bytes, this routine deserializes and decompresses it to a degree-255 polynomial with signed
+// 16 -bit coefficients, in a single pass, producing same coefficients as the portable `decode_decompress<d>` does.
+template<size_t d>
+ML_KEM_TARGET_AVX2 inline void
+decode_decompress(std::span<const uint8_t, 32 * d> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  decompress_map_t<d> map{};
+  decode_mapped<d>(arr, poly, map);
+}
+
+}
+#endif
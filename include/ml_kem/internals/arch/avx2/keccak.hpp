@@ -0,0 +1,75 @@
+#pragma once
+#include "ml_kem/internals/keccak/keccak.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// AVX2 implementation of Keccak-f[1600] permutation, applied on 4 independent states at once.
+namespace ml_kem_keccak::avx2 {
+
+// Number of Keccak-f[1600] states, which are permuted together.
+inline constexpr size_t LANES = 4;
+
+// Rotates each 64 -bit lane of `a` to left by `n` ( ∈ [0, 64) ) bits.
+ML_KEM_TARGET_AVX2 inline __m256i
+rotl(const __m256i a, const int n)
+{
+  const __m128i l = _mm_cvtsi32_si128(n);
+  const __m128i r = _mm_cvtsi32_si128((64 - n) & 63);
+
+  return _mm256_or_si256(_mm256_sll_epi64(a, l), _mm256_srl_epi64(a, r));
+}
+
+// Given 4 interleaved Keccak-f[1600] states s.t. lane i of state j lives at index i * 4 + j, this routine applies all 24 rounds of
+// the permutation on each of them, in-place. Each state lane is kept in a 256 -bit register.
+ML_KEM_TARGET_AVX2 inline void
+permute_x4(std::span<uint64_t, LANE_CNT * LANES> state)
+{
+  __m256i a[LANE_CNT]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  __m256i b[LANE_CNT]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  __m256i c[5];        // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    a[i] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(state.data() + (i * LANES))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+
+  for (size_t r = 0; r < NUM_ROUNDS; r++) {
+    // θ
+    for (size_t x = 0; x < 5; x++) {
+      const __m256i t = _mm256_xor_si256(_mm256_xor_si256(a[x], a[x + 5]), a[x + 10]);
+      c[x] = _mm256_xor_si256(_mm256_xor_si256(t, a[x + 15]), a[x + 20]);
+    }
+    for (size_t x = 0; x < 5; x++) {
+      const __m256i d = _mm256_xor_si256(c[(x + 4) % 5], rotl(c[(x + 1) % 5], 1));
+      for (size_t y = 0; y < 5; y++) {
+        a[x + 5 * y] = _mm256_xor_si256(a[x + 5 * y], d);
+      }
+    }
+
+    // ρ and π
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      b[PI_INDICES[i]] = rotl(a[i], ROTATION_OFFSETS[i]);
+    }
+
+    // χ
+    for (size_t y = 0; y < 5; y++) {
+      for (size_t x = 0; x < 5; x++) {
+        a[x + 5 * y] = _mm256_xor_si256(b[x + 5 * y], _mm256_andnot_si256(b[((x + 1) % 5) + 5 * y], b[((x + 2) % 5) + 5 * y]));
+      }
+    }
+
+    // ι
+    a[0] = _mm256_xor_si256(a[0], _mm256_set1_epi64x(static_cast<int64_t>(ROUND_CONSTANTS[r])));
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(state.data() + (i * LANES)), a[i]); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+
+}
+#endif
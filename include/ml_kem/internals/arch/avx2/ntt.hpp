@@ -0,0 +1,614 @@
+#pragma once
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// AVX2 implementation of NTT, iNTT and polynomial multiplication in NTT domain, operating on 16 lanes of 16 -bit coefficients.
+//
+// Kernels operate on signed 16 -bit coefficients, using the Montgomery arithmetic of `ml_kem_field::fqmul` et al., lane-wise.
+// Wrappers over `zq_t` polynomials convert coefficients on entry and back to canonical form on exit, so that results are
+// bit-identical to the portable implementation.
+namespace ml_kem_ntt::avx2 {
+
+static_assert(sizeof(ml_kem_field::zq_t) == sizeof(uint32_t), "zq_t must be layout compatible with uint32_t");
+
+using ml_kem_field::BARRETT_V;
+using ml_kem_field::make_twiddle;
+using ml_kem_field::mul_qinv;
+using ml_kem_field::QINV;
+using ml_kem_field::R2_MOD_Q;
+using ml_kem_field::twiddle_t;
+
+inline constexpr int16_t Q = ml_kem_field::Q16;
+
+// Last few layers of NTT ( and first few layers of iNTT ) operate on pairs of coefficients which live in the same register. Those
+// layers are computed after shuffling a pair of registers, holding 2 x `lanes` consecutive coefficients, such that the first register
+// holds the "upper" and second register holds the "lower" operand of each butterfly. After shuffling for layer with distance `len`,
+// lane j of the first register holds coefficient at following offset, w.r.t. start of the block. The second register always holds
+// coefficients at offset + len.
+constexpr size_t
+shuffled_lane_offset(const size_t len, const size_t lane)
+{
+  return ((lane / len) * 2 * len) + (lane % len);
+}
+
+// Per-lane twiddle factors, for one pair of registers and one layer.
+template<size_t lanes>
+struct lane_twiddles_t
+{
+  std::array<int16_t, lanes> zeta{};
+  std::array<int16_t, lanes> zeta_qinv{};
+};
+
+// Per-lane twiddle factors for layers with len = lanes, lanes/2, ..., 4, 2 of forward NTT ( when `inverse` is false ) or inverse NTT,
+// computed while keeping a pair of registers resident. Factors of each pair of registers are laid out contiguously, in the order
+// they are consumed, i.e. from len = lanes to len = 2 for forward NTT and the other way around for inverse NTT.
+template<bool inverse, size_t lanes>
+constexpr auto
+make_lane_twiddles()
+{
+  constexpr size_t layer_cnt = static_cast<size_t>(std::bit_width(lanes)) - 1;
+  constexpr size_t pair_cnt = N / (2 * lanes);
+
+  std::array<std::array<lane_twiddles_t<lanes>, layer_cnt>, pair_cnt> res{};
+
+  for (size_t pair = 0; pair < pair_cnt; pair++) {
+    for (size_t step = 0; step < layer_cnt; step++) {
+      const size_t lvl = inverse ? (step + 1) : (layer_cnt - step);
+      const size_t len = static_cast<size_t>(1) << lvl;
+
+      for (size_t lane = 0; lane < lanes; lane++) {
+        const size_t coeff_idx = (pair * 2 * lanes) + shuffled_lane_offset(len, lane);
+        const size_t blk_idx = coeff_idx / (2 * len);
+
+        twiddle_t tw{};
+        if constexpr (inverse) {
+          tw = make_twiddle(INTT_ZETA_EXP[(N >> lvl) - 1 - blk_idx]);
+        } else {
+          tw = make_twiddle(NTT_ZETA_EXP[(N >> (lvl + 1)) + blk_idx]);
+        }
+
+        res[pair][step].zeta[lane] = tw.zeta;
+        res[pair][step].zeta_qinv[lane] = tw.zeta_qinv;
+      }
+    }
+  }
+
+  return res;
+}
+
+// Twiddle factors for layers with len = 128, ..., 2^lvl_lo, where butterflies operate on whole registers, in the order they are
+// consumed, i.e. layer by layer, block by block. For inverse NTT, twiddle factor of the last layer is multiplied by N^-1, folding
+// scaling of output into that layer.
+template<bool inverse, size_t lvl_lo>
+constexpr auto
+make_reg_twiddles()
+{
+  constexpr size_t cnt = (N >> lvl_lo) - 1;
+  std::array<twiddle_t, cnt> res{};
+
+  for (size_t i = 0; i < cnt; i++) {
+    if constexpr (inverse) {
+      res[i] = (i == cnt - 1) ? INTT_LAST_TWIDDLE : INTT_TWIDDLES[cnt - i];
+    } else {
+      res[i] = NTT_TWIDDLES[i + 1];
+    }
+  }
+
+  return res;
+}
+
+// Per-lane powers of ζ, used during base case multiplication. Even and odd coefficients of each pair of registers are separated
+// such that lane 2i holds degree-1 polynomial number i and lane 2i+1 holds degree-1 polynomial number lanes/2 + i, w.r.t. the
+// first degree-1 polynomial in the block.
+template<size_t lanes>
+constexpr auto
+make_basemul_lane_twiddles()
+{
+  constexpr size_t pair_cnt = N / (2 * lanes);
+  std::array<lane_twiddles_t<lanes>, pair_cnt> res{};
+
+  for (size_t pair = 0; pair < pair_cnt; pair++) {
+    for (size_t lane = 0; lane < lanes; lane++) {
+      const size_t poly_idx = (pair * lanes) + (lane >> 1) + ((lane & 1) * (lanes / 2));
+      const auto tw = make_twiddle(POLY_MUL_ZETA_EXP[poly_idx]);
+
+      res[pair].zeta[lane] = tw.zeta;
+      res[pair].zeta_qinv[lane] = tw.zeta_qinv;
+    }
+  }
+
+  return res;
+}
+
+inline constexpr auto NTT_LANE_TWIDDLES = make_lane_twiddles<false, 16>();
+inline constexpr auto INTT_LANE_TWIDDLES = make_lane_twiddles<true, 16>();
+inline constexpr auto NTT_REG_TWIDDLES = make_reg_twiddles<false, 5>();
+inline constexpr auto INTT_REG_TWIDDLES = make_reg_twiddles<true, 5>();
+inline constexpr auto BASEMUL_LANE_TWIDDLES = make_basemul_lane_twiddles<16>();
+
+// Powers of ζ, in Montgomery form, used during fused multiply-accumulate, which keeps degree-1 polynomials interleaved, as they are
+// in memory. Lane 2i+1 holds the one for degree-1 polynomial number i, while even lanes are zero.
+inline constexpr auto BASEMUL_PAIR_ZETAS = []() {
+  std::array<int16_t, N> res{};
+  for (size_t i = 0; i < N / 2; i++) {
+    res[2 * i + 1] = make_twiddle(POLY_MUL_ZETA_EXP[i]).zeta;
+  }
+
+  return res;
+}();
+
+ML_KEM_TARGET_AVX2 inline __m256i
+load(const int16_t* const ptr)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+ML_KEM_TARGET_AVX2 inline void
+store(int16_t* const ptr, const __m256i v)
+{
+  _mm256_storeu_si256(reinterpret_cast<__m256i*>(ptr), v); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+}
+
+// Montgomery multiplication of each lane of `a` with corresponding lane of `b`, where `b_qinv` = b * q^-1 mod 2^16.
+// Computes a * b * 2^-16 mod q, as a representative ∈ (-q, q), given that |a * b| < q * 2^15.
+ML_KEM_TARGET_AVX2 inline __m256i
+fqmul(const __m256i a, const __m256i b, const __m256i b_qinv)
+{
+  const __m256i lo = _mm256_mullo_epi16(a, b_qinv);
+  const __m256i hi = _mm256_mulhi_epi16(a, b);
+  const __m256i t = _mm256_mulhi_epi16(lo, _mm256_set1_epi16(Q));
+
+  return _mm256_sub_epi16(hi, t);
+}
+
+// Same as above, but when b * q^-1 is not precomputed.
+ML_KEM_TARGET_AVX2 inline __m256i
+fqmul(const __m256i a, const __m256i b)
+{
+  return fqmul(a, b, _mm256_mullo_epi16(b, _mm256_set1_epi16(QINV)));
+}
+
+// Barrett reduction of each signed 16 -bit lane, producing a representative ∈ [-q, 2q).
+ML_KEM_TARGET_AVX2 inline __m256i
+barrett_reduce(const __m256i a)
+{
+  const __m256i t0 = _mm256_mulhi_epi16(a, _mm256_set1_epi16(BARRETT_V));
+  const __m256i t1 = _mm256_srai_epi16(t0, 10);
+  const __m256i t2 = _mm256_mullo_epi16(t1, _mm256_set1_epi16(Q));
+
+  return _mm256_sub_epi16(a, t2);
+}
+
+// Given signed 16 -bit lanes, each ∈ [-q, 2q), this routine computes canonical representative ∈ [0, q).
+ML_KEM_TARGET_AVX2 inline __m256i
+canonicalize(const __m256i a)
+{
+  const __m256i q = _mm256_set1_epi16(Q);
+
+  const __m256i t0 = _mm256_add_epi16(a, _mm256_and_si256(_mm256_cmpgt_epi16(_mm256_setzero_si256(), a), q));
+  const __m256i t1 = _mm256_sub_epi16(t0, _mm256_and_si256(_mm256_cmpgt_epi16(t0, _mm256_set1_epi16(Q - 1)), q));
+
+  return t1;
+}
+
+// Cooley-Tukey butterfly, used in forward NTT.
+ML_KEM_TARGET_AVX2 inline void
+ct_butterfly(__m256i& a, __m256i& b, const __m256i zeta, const __m256i zeta_qinv)
+{
+  const __m256i t = fqmul(b, zeta, zeta_qinv);
+
+  b = _mm256_sub_epi16(a, t);
+  a = _mm256_add_epi16(a, t);
+}
+
+// Gentleman-Sande butterfly, used in inverse NTT.
+ML_KEM_TARGET_AVX2 inline void
+gs_butterfly(__m256i& a, __m256i& b, const __m256i zeta, const __m256i zeta_qinv)
+{
+  const __m256i t = _mm256_sub_epi16(a, b);
+
+  a = _mm256_add_epi16(a, b);
+  b = fqmul(t, zeta, zeta_qinv);
+}
+
+// Following three routines shuffle a pair of registers, such that lanes, which are `len` = 8, 4 and 2 coefficients apart, are
+// placed in the same lane of two registers. Each of them is an involution, so applying it twice restores the original layout.
+ML_KEM_TARGET_AVX2 inline void
+shuffle8(__m256i& a, __m256i& b)
+{
+  const __m256i t0 = _mm256_permute2x128_si256(a, b, 0x20);
+  const __m256i t1 = _mm256_permute2x128_si256(a, b, 0x31);
+
+  a = t0;
+  b = t1;
+}
+
+ML_KEM_TARGET_AVX2 inline void
+shuffle4(__m256i& a, __m256i& b)
+{
+  const __m256i t0 = _mm256_unpacklo_epi64(a, b);
+  const __m256i t1 = _mm256_unpackhi_epi64(a, b);
+
+  a = t0;
+  b = t1;
+}
+
+ML_KEM_TARGET_AVX2 inline void
+shuffle2(__m256i& a, __m256i& b)
+{
+  const __m256i t0 = _mm256_blend_epi32(a, _mm256_slli_epi64(b, 32), 0b10101010);
+  const __m256i t1 = _mm256_blend_epi32(_mm256_srli_epi64(a, 32), b, 0b10101010);
+
+  a = t0;
+  b = t1;
+}
+
+// Separates even and odd 16 -bit lanes of a pair of registers ( and it's also an involution ).
+ML_KEM_TARGET_AVX2 inline void
+shuffle1(__m256i& a, __m256i& b)
+{
+  const __m256i t0 = _mm256_blend_epi16(a, _mm256_slli_epi32(b, 16), 0b10101010);
+  const __m256i t1 = _mm256_blend_epi16(_mm256_srli_epi32(a, 16), b, 0b10101010);
+
+  a = t0;
+  b = t1;
+}
+
+// Converts 256 canonical coefficients of a polynomial to 16 -bit lanes.
+ML_KEM_TARGET_AVX2 inline void
+pack(std::span<const ml_kem_field::zq_t, N> src, std::span<int16_t, N> dst)
+{
+  for (size_t i = 0; i < N; i += 16) {
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + i));     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src.data() + i + 8)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    store(dst.data() + i, _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0b11011000));
+  }
+}
+
+// Converts 256 canonical coefficients, held in 16 -bit lanes, back to `zq_t` form.
+ML_KEM_TARGET_AVX2 inline void
+unpack(std::span<const int16_t, N> src, std::span<ml_kem_field::zq_t, N> dst)
+{
+  for (size_t i = 0; i < N; i += 16) {
+    const __m256i v = load(src.data() + i);
+
+    const __m256i lo = _mm256_cvtepu16_epi32(_mm256_castsi256_si128(v));
+    const __m256i hi = _mm256_cvtepu16_epi32(_mm256_extracti128_si256(v, 1));
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data() + i), lo);     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst.data() + i + 8), hi); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+
+// Butterflies with a single twiddle factor, broadcasted to all lanes, or with per-lane twiddle factors.
+ML_KEM_TARGET_AVX2 inline void
+ct_butterfly(__m256i& a, __m256i& b, const twiddle_t tw)
+{
+  ct_butterfly(a, b, _mm256_set1_epi16(tw.zeta), _mm256_set1_epi16(tw.zeta_qinv));
+}
+
+ML_KEM_TARGET_AVX2 inline void
+ct_butterfly(__m256i& a, __m256i& b, const lane_twiddles_t<16>& tw)
+{
+  ct_butterfly(a, b, load(tw.zeta.data()), load(tw.zeta_qinv.data()));
+}
+
+ML_KEM_TARGET_AVX2 inline void
+gs_butterfly(__m256i& a, __m256i& b, const twiddle_t tw)
+{
+  gs_butterfly(a, b, _mm256_set1_epi16(tw.zeta), _mm256_set1_epi16(tw.zeta_qinv));
+}
+
+ML_KEM_TARGET_AVX2 inline void
+gs_butterfly(__m256i& a, __m256i& b, const lane_twiddles_t<16>& tw)
+{
+  gs_butterfly(a, b, load(tw.zeta.data()), load(tw.zeta_qinv.data()));
+}
+
+// Forward NTT over 16 -bit lanes. Input coefficients must be ∈ (-q, q), output coefficients are ∈ [0, q), in bit-reversed order.
+//
+// Layers are merged into two passes over the polynomial, each keeping a block of coefficients resident in registers, while it
+// goes through three or four layers.
+ML_KEM_TARGET_AVX2 inline void
+ntt(std::span<int16_t, N> poly)
+{
+  // Layers with len = 128, 64, 32, where butterflies operate on whole registers. Each block is a column of eight registers,
+  // holding coefficients which are 32 apart.
+  for (size_t col = 0; col < 32; col += 16) {
+    __m256i r[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+    for (size_t i = 0; i < 8; i++) {
+      r[i] = load(poly.data() + col + i * 32);
+    }
+
+    const auto& tw = NTT_REG_TWIDDLES;
+
+    ct_butterfly(r[0], r[4], tw[0]);
+    ct_butterfly(r[1], r[5], tw[0]);
+    ct_butterfly(r[2], r[6], tw[0]);
+    ct_butterfly(r[3], r[7], tw[0]);
+
+    ct_butterfly(r[0], r[2], tw[1]);
+    ct_butterfly(r[1], r[3], tw[1]);
+    ct_butterfly(r[4], r[6], tw[2]);
+    ct_butterfly(r[5], r[7], tw[2]);
+
+    ct_butterfly(r[0], r[1], tw[3]);
+    ct_butterfly(r[2], r[3], tw[4]);
+    ct_butterfly(r[4], r[5], tw[5]);
+    ct_butterfly(r[6], r[7], tw[6]);
+
+    for (size_t i = 0; i < 8; i++) {
+      store(poly.data() + col + i * 32, r[i]);
+    }
+  }
+
+  // Layers with len = 16, 8, 4, 2, computed while keeping a pair of registers, holding 32 consecutive coefficients, resident.
+  for (size_t pair = 0; pair < 8; pair++) {
+    const size_t off = pair * 32;
+    const auto& tw = NTT_LANE_TWIDDLES[pair];
+
+    __m256i a = load(poly.data() + off);
+    __m256i b = load(poly.data() + off + 16);
+
+    ct_butterfly(a, b, tw[0]);
+    shuffle8(a, b);
+    ct_butterfly(a, b, tw[1]);
+    shuffle4(a, b);
+    ct_butterfly(a, b, tw[2]);
+    shuffle2(a, b);
+    ct_butterfly(a, b, tw[3]);
+
+    shuffle2(a, b);
+    shuffle4(a, b);
+    shuffle8(a, b);
+
+    // Each coefficient is now ∈ (-8q, 8q).
+    store(poly.data() + off, canonicalize(barrett_reduce(a)));
+    store(poly.data() + off + 16, canonicalize(barrett_reduce(b)));
+  }
+}
+
+// Inverse NTT over 16 -bit lanes. Input coefficients must be ∈ (-q, q), in bit-reversed order, output coefficients are ∈ [0, q).
+//
+// Same two passes as forward NTT, in reverse. Sums are reduced after layers with len = 8 and len = 32, following the schedule
+// proven by `ml_kem_ntt::scalar::intt`, while scaling by N^-1 is folded into the last layer.
+ML_KEM_TARGET_AVX2 inline void
+intt(std::span<int16_t, N> poly)
+{
+  // Layers with len = 2, 4, 8, 16.
+  for (size_t pair = 0; pair < 8; pair++) {
+    const size_t off = pair * 32;
+    const auto& tw = INTT_LANE_TWIDDLES[pair];
+
+    __m256i a = load(poly.data() + off);
+    __m256i b = load(poly.data() + off + 16);
+
+    shuffle8(a, b);
+    shuffle4(a, b);
+    shuffle2(a, b);
+
+    gs_butterfly(a, b, tw[0]);
+    shuffle2(a, b);
+    gs_butterfly(a, b, tw[1]);
+    shuffle4(a, b);
+    gs_butterfly(a, b, tw[2]);
+    a = barrett_reduce(a);
+    shuffle8(a, b);
+    gs_butterfly(a, b, tw[3]);
+
+    store(poly.data() + off, a);
+    store(poly.data() + off + 16, b);
+  }
+
+  // Layers with len = 32, 64, 128.
+  const __m256i inv_n = _mm256_set1_epi16(INV_N_TWIDDLE.zeta);
+  const __m256i inv_n_qinv = _mm256_set1_epi16(INV_N_TWIDDLE.zeta_qinv);
+
+  for (size_t col = 0; col < 32; col += 16) {
+    __m256i r[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+    for (size_t i = 0; i < 8; i++) {
+      r[i] = load(poly.data() + col + i * 32);
+    }
+
+    const auto& tw = INTT_REG_TWIDDLES;
+
+    gs_butterfly(r[0], r[1], tw[0]);
+    gs_butterfly(r[2], r[3], tw[1]);
+    gs_butterfly(r[4], r[5], tw[2]);
+    gs_butterfly(r[6], r[7], tw[3]);
+    for (size_t i = 0; i < 8; i += 2) {
+      r[i] = barrett_reduce(r[i]);
+    }
+
+    gs_butterfly(r[0], r[2], tw[4]);
+    gs_butterfly(r[1], r[3], tw[4]);
+    gs_butterfly(r[4], r[6], tw[5]);
+    gs_butterfly(r[5], r[7], tw[5]);
+
+    // Last layer, whose twiddle factor is already scaled by N^-1, while sums are scaled explicitly.
+    for (size_t i = 0; i < 4; i++) {
+      gs_butterfly(r[i], r[i + 4], tw[6]);
+      r[i] = fqmul(r[i], inv_n, inv_n_qinv);
+    }
+
+    for (size_t i = 0; i < 8; i++) {
+      store(poly.data() + col + i * 32, canonicalize(r[i]));
+    }
+  }
+}
+
+// Given two polynomials in NTT domain, with coefficients ∈ (-q, q) held in 16 -bit lanes, this routine computes 128 base case
+// multiplications of degree-1 polynomials, writing canonical coefficients of product polynomial to `h`.
+ML_KEM_TARGET_AVX2 inline void
+polymul(std::span<const int16_t, N> f, std::span<const int16_t, N> g, std::span<int16_t, N> h)
+{
+  const __m256i r2 = _mm256_set1_epi16(R2_MOD_Q);
+  const __m256i r2_qinv = _mm256_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t pair = 0; pair < 8; pair++) {
+    const size_t off = pair * 32;
+
+    __m256i f0 = load(f.data() + off);
+    __m256i f1 = load(f.data() + off + 16);
+    __m256i g0 = load(g.data() + off);
+    __m256i g1 = load(g.data() + off + 16);
+
+    shuffle1(f0, f1);
+    shuffle1(g0, g1);
+
+    const __m256i zeta = load(BASEMUL_LANE_TWIDDLES[pair].zeta.data());
+    const __m256i zeta_qinv = load(BASEMUL_LANE_TWIDDLES[pair].zeta_qinv.data());
+
+    // h0 = f0 * g0 + f1 * g1 * ζ and h1 = f0 * g1 + f1 * g0, all scaled by 2^-16, each ∈ (-2q, 2q).
+    const __m256i t0 = fqmul(fqmul(f1, g1), zeta, zeta_qinv);
+    __m256i h0 = _mm256_add_epi16(fqmul(f0, g0), t0);
+    __m256i h1 = _mm256_add_epi16(fqmul(f0, g1), fqmul(f1, g0));
+
+    h0 = canonicalize(fqmul(h0, r2, r2_qinv));
+    h1 = canonicalize(fqmul(h1, r2, r2_qinv));
+
+    shuffle1(h0, h1);
+
+    store(h.data() + off, h0);
+    store(h.data() + off + 16, h1);
+  }
+}
+
+// Montgomery reduction of each signed 32 -bit lane a | |a| < q * 2^15, computing a * 2^-16 mod q, as a representative ∈ (-q, q),
+// which is left in the upper 16 -bit half of the lane. As lower 16 -bit halves of a and t * q are equal, upper halves can be
+// subtracted without any borrow.
+ML_KEM_TARGET_AVX2 inline __m256i
+montgomery_reduce(const __m256i a)
+{
+  const __m256i t = _mm256_mullo_epi16(a, _mm256_set1_epi16(QINV));
+  const __m256i tq = _mm256_mulhi_epi16(t, _mm256_set1_epi16(Q));
+
+  return _mm256_sub_epi16(a, _mm256_slli_epi32(tq, 16));
+}
+
+// Given `cnt` pairs of polynomials in NTT domain, with coefficients ∈ (-q, q) held in 16 -bit lanes, this routine computes the sum
+// of their products h = Σ f_i ◦ g_i, writing canonical coefficients to `h`.
+//
+// Both coefficients of a degree-1 polynomial live in the same 32 -bit lane, so `vpmaddwd` computes f0 * g0 + (f1 * g1) * ζ and
+// f0 * g1 + f1 * g0 without any shuffling, accumulating them in 32 -bit lanes. Those are Montgomery reduced only once, at the end.
+// Bound on accumulators is proven by `ml_kem_ntt::scalar::polymul_acc`.
+template<size_t cnt>
+ML_KEM_TARGET_AVX2 inline void
+polymul_acc(std::span<const int16_t, cnt * N> f, std::span<const int16_t, cnt * N> g, std::span<int16_t, N> h)
+{
+  const __m256i r2 = _mm256_set1_epi16(R2_MOD_Q);
+  const __m256i r2_qinv = _mm256_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t off = 0; off < N; off += 16) {
+    const __m256i zeta = load(BASEMUL_PAIR_ZETAS.data() + off);
+
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < cnt; i++) {
+      const __m256i fv = load(f.data() + i * N + off);
+      const __m256i gv = load(g.data() + i * N + off);
+
+      // (f0, f1 * g1 * 2^-16) . (g0, ζ * 2^16)
+      const __m256i t0 = _mm256_blend_epi16(fv, fqmul(fv, gv), 0xAA);
+      const __m256i t1 = _mm256_blend_epi16(gv, zeta, 0xAA);
+      acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(t0, t1));
+
+      // (f0, f1) . (g1, g0)
+      const __m256i gs = _mm256_or_si256(_mm256_slli_epi32(gv, 16), _mm256_srli_epi32(gv, 16));
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(fv, gs));
+    }
+
+    const __m256i h0 = _mm256_srli_epi32(montgomery_reduce(acc0), 16);
+    const __m256i h1 = montgomery_reduce(acc1);
+
+    store(h.data() + off, canonicalize(fqmul(_mm256_blend_epi16(h0, h1, 0xAA), r2, r2_qinv)));
+  }
+}
+
+// Same as `polymul_acc` above, but using multiplication cache of each of g_i ( see `ml_kem_ntt::scalar::mulcache` ), which is
+// interleaved with g0 coefficients, so that f0 * g0 + f1 * g1 * ζ is computed by a single `vpmaddwd`.
+template<size_t cnt>
+ML_KEM_TARGET_AVX2 inline void
+polymul_acc(std::span<const int16_t, cnt * N> f,
+            std::span<const int16_t, cnt * N> g,
+            std::span<const int16_t, cnt * N / 2> g_cache,
+            std::span<int16_t, N> h)
+{
+  const __m256i r2 = _mm256_set1_epi16(R2_MOD_Q);
+  const __m256i r2_qinv = _mm256_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t off = 0; off < N; off += 16) {
+    __m256i acc0 = _mm256_setzero_si256();
+    __m256i acc1 = _mm256_setzero_si256();
+
+    for (size_t i = 0; i < cnt; i++) {
+      const __m256i fv = load(f.data() + i * N + off);
+      const __m256i gv = load(g.data() + i * N + off);
+      const __m128i cv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(g_cache.data() + i * (N / 2) + off / 2)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      // (f0, f1) . (g0, g1 * ζ)
+      const __m256i t = _mm256_blend_epi16(gv, _mm256_slli_epi32(_mm256_cvtepu16_epi32(cv), 16), 0xAA);
+      acc0 = _mm256_add_epi32(acc0, _mm256_madd_epi16(fv, t));
+
+      // (f0, f1) . (g1, g0)
+      const __m256i gs = _mm256_or_si256(_mm256_slli_epi32(gv, 16), _mm256_srli_epi32(gv, 16));
+      acc1 = _mm256_add_epi32(acc1, _mm256_madd_epi16(fv, gs));
+    }
+
+    const __m256i h0 = _mm256_srli_epi32(montgomery_reduce(acc0), 16);
+    const __m256i h1 = montgomery_reduce(acc1);
+
+    store(h.data() + off, canonicalize(fqmul(_mm256_blend_epi16(h0, h1, 0xAA), r2, r2_qinv)));
+  }
+}
+
+// Forward NTT over polynomial with `zq_t` coefficients, producing bit-identical result as `ml_kem_ntt::scalar::ntt`.
+ML_KEM_TARGET_AVX2 inline void
+ntt(std::span<ml_kem_field::zq_t, N> poly)
+{
+  alignas(32) std::array<int16_t, N> buf{};
+
+  pack(poly, buf);
+  ntt(std::span(buf));
+  unpack(buf, poly);
+}
+
+// Inverse NTT over polynomial with `zq_t` coefficients, producing bit-identical result as `ml_kem_ntt::scalar::intt`.
+ML_KEM_TARGET_AVX2 inline void
+intt(std::span<ml_kem_field::zq_t, N> poly)
+{
+  alignas(32) std::array<int16_t, N> buf{};
+
+  pack(poly, buf);
+  intt(std::span(buf));
+  unpack(buf, poly);
+}
+
+// Polynomial multiplication in NTT domain, producing bit-identical result as `ml_kem_ntt::scalar::polymul`.
+ML_KEM_TARGET_AVX2 inline void
+polymul(std::span<const ml_kem_field::zq_t, N> f, std::span<const ml_kem_field::zq_t, N> g, std::span<ml_kem_field::zq_t, N> h)
+{
+  alignas(32) std::array<int16_t, N> f_buf{};
+  alignas(32) std::array<int16_t, N> g_buf{};
+  alignas(32) std::array<int16_t, N> h_buf{};
+
+  pack(f, f_buf);
+  pack(g, g_buf);
+  polymul(f_buf, g_buf, h_buf);
+  unpack(h_buf, h);
+}
+
+}
+#endif
@@ -0,0 +1,176 @@
+#pragma once
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// AVX2 implementation of rejection sampling of uniform polynomials in NTT representation, parsing 16 candidate coefficients at once, and
+// of sampling polynomials from centered binomial distribution, computing 32 or 64 coefficients at once.
+namespace ml_kem_utils::avx2 {
+
+// Number of candidate coefficients parsed in a single step, from 24 bytes of XOF output.
+inline constexpr size_t REJ_CANDIDATES = 16;
+
+// Number of bytes of XOF output consumed in a single step.
+inline constexpr size_t REJ_STEP_BYTES = (REJ_CANDIDATES * 12) / 8;
+
+// For each 8 -bit mask of accepted candidates, in a half of a step, a byte shuffle which moves accepted 16 -bit candidates to the
+// front of a 128 -bit register, keeping their order. Rest of the register is zeroed.
+constexpr auto
+make_rej_shuffle_table()
+{
+  std::array<std::array<uint8_t, 16>, 256> res{};
+
+  for (size_t mask = 0; mask < res.size(); mask++) {
+    res[mask].fill(0x80);
+
+    size_t idx = 0;
+    for (size_t i = 0; i < 8; i++) {
+      if (((mask >> i) & 1) == 1) {
+        res[mask][(2 * idx) + 0] = static_cast<uint8_t>((2 * i) + 0);
+        res[mask][(2 * idx) + 1] = static_cast<uint8_t>((2 * i) + 1);
+        idx++;
+      }
+    }
+  }
+
+  return res;
+}
+
+inline constexpr auto REJ_SHUFFLE_TABLE = make_rej_shuffle_table();
+
+// Given a byte stream, this routine parses it as 12 -bit candidate coefficients, 16 at a time, writing those which are less than q
+// to `poly`, starting at `coeff_idx`, same as `parse_ntt_coeffs` does. It keeps going as long as the next step can neither read past
+// end of `buf` nor write past end of `poly`, leaving the rest to scalar parsing. Returns number of bytes consumed, which is always a
+// multiple of 24, while `coeff_idx` is advanced past all accepted coefficients.
+//
+// Coefficients of `poly` at index >= `coeff_idx` may be overwritten, with garbage, until they get sampled.
+ML_KEM_TARGET_AVX2 inline size_t
+rej_uniform(std::span<const uint8_t> buf, std::span<int16_t, ml_kem_ntt::N> poly, size_t& coeff_idx)
+{
+  // Two 24 -bit groups, each holding two candidates, are spread over three 16 -bit lanes; so for lane 2i, the candidate is the
+  // lower 12 bits of bytes (3i, 3i + 1), while for lane 2i + 1, it is the upper 12 bits of bytes (3i + 1, 3i + 2). Upper 128 -bit half
+  // of a step starts at byte 12, which is byte 4 of the upper half of the register, after permuting 64 -bit words as [0, 1, 1, 2].
+  const __m256i idx = _mm256_setr_epi8(0, 1, 1, 2, 3, 4, 4, 5, 6, 7, 7, 8, 9, 10, 10, 11, 4, 5, 5, 6, 7, 8, 8, 9, 10, 11, 11, 12, 13, 14, 14, 15);
+  const __m256i mask12 = _mm256_set1_epi16(0x0fff);
+  const __m256i q = _mm256_set1_epi16(ml_kem_field::Q16);
+
+  size_t off = 0;
+
+  while (((off + sizeof(__m256i)) <= buf.size()) && ((coeff_idx + REJ_CANDIDATES) <= poly.size())) {
+    __m256i f = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buf.data() + off)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    f = _mm256_permute4x64_epi64(f, 0x94);
+    f = _mm256_shuffle_epi8(f, idx);
+
+    const __m256i d = _mm256_blend_epi16(_mm256_and_si256(f, mask12), _mm256_srli_epi16(f, 4), 0xaa);
+    const __m256i good = _mm256_cmpgt_epi16(q, d);
+
+    // Bits [0, 8) and [16, 24) hold acceptance of candidates in lower and upper half, respectively.
+    const auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_packs_epi16(good, _mm256_setzero_si256())));
+    const uint32_t bits_lo = bits & 0xffu;
+    const uint32_t bits_hi = (bits >> 16) & 0xffu;
+
+    const __m128i shuf_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(REJ_SHUFFLE_TABLE[bits_lo].data())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i shuf_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(REJ_SHUFFLE_TABLE[bits_hi].data())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    const __m128i d_lo = _mm_shuffle_epi8(_mm256_castsi256_si128(d), shuf_lo);
+    const __m128i d_hi = _mm_shuffle_epi8(_mm256_extracti128_si256(d, 1), shuf_hi);
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(poly.data() + coeff_idx), d_lo); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    coeff_idx += static_cast<size_t>(std::popcount(bits_lo));
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(poly.data() + coeff_idx), d_hi); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    coeff_idx += static_cast<size_t>(std::popcount(bits_hi));
+
+    off += REJ_STEP_BYTES;
+  }
+
+  return off;
+}
+
+// Given 128 -bytes PRF output, this routine samples a polynomial from centered binomial distribution with η = 2, same as the portable
+// `sample_poly_cbd<2>` does, computing 64 coefficients from 32 bytes at a time. Within each byte, sums of bit pairs are computed for
+// both nibbles at once and subtracted from each other, biased by 3, so that bytes never borrow from each other. Coefficients ∈ [-2, 2].
+ML_KEM_TARGET_AVX2 inline void
+cbd2(std::span<const uint8_t, 128> prf, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  const __m256i mask55 = _mm256_set1_epi8(0x55);
+  const __m256i mask33 = _mm256_set1_epi8(0x33);
+  const __m256i mask0f = _mm256_set1_epi8(0x0f);
+  const __m256i bias = _mm256_set1_epi8(3);
+
+  for (size_t i = 0; i < prf.size() / sizeof(__m256i); i++) {
+    __m256i f0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(prf.data() + (i * sizeof(__m256i)))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    __m256i f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 1), mask55);
+    f0 = _mm256_add_epi8(_mm256_and_si256(f0, mask55), f1);
+
+    // Each nibble holds (sum of first bit pair) + 3 - (sum of second bit pair).
+    f1 = _mm256_and_si256(_mm256_srli_epi16(f0, 2), mask33);
+    f0 = _mm256_sub_epi8(_mm256_add_epi8(_mm256_and_si256(f0, mask33), mask33), f1);
+
+    // Byte j of `lo` and `hi` holds coefficient 2j and 2j + 1, respectively.
+    const __m256i lo = _mm256_sub_epi8(_mm256_and_si256(f0, mask0f), bias);
+    const __m256i hi = _mm256_sub_epi8(_mm256_and_si256(_mm256_srli_epi16(f0, 4), mask0f), bias);
+
+    const __m256i c0 = _mm256_unpacklo_epi8(lo, hi);
+    const __m256i c1 = _mm256_unpackhi_epi8(lo, hi);
+
+    int16_t* const dst = poly.data() + (i * 64);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 0), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(c0)));      // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 16), _mm256_cvtepi8_epi16(_mm256_castsi256_si128(c1)));     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 32), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(c0, 1))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 48), _mm256_cvtepi8_epi16(_mm256_extracti128_si256(c1, 1))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+
+// Given 192 -bytes PRF output, this routine samples a polynomial from centered binomial distribution with η = 3, same as the portable
+// `sample_poly_cbd<3>` does, computing 32 coefficients from 24 bytes at a time. Each 24 -bit word, yielding four coefficients, is
+// spread over a 32 -bit lane, where sums of bit triples are computed and subtracted from each other, biased by 3. Coefficients ∈ [-3, 3].
+ML_KEM_TARGET_AVX2 inline void
+cbd3(std::span<const uint8_t, 192> prf, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  // Lower 128 -bit half holds bytes [0, 16) and upper half holds bytes [8, 24) of each 24 -bytes chunk, of which four 3 -bytes words
+  // are spread over 32 -bit lanes.
+  const __m256i idx = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1, 4, 5, 6, -1, 7, 8, 9, -1, 10, 11, 12, -1, 13, 14, 15, -1);
+  const __m256i mask249 = _mm256_set1_epi32(0x249249);
+  const __m256i mask6db = _mm256_set1_epi32(0x6db6db);
+  const __m256i mask07 = _mm256_set1_epi32(7);
+  const __m256i mask70 = _mm256_set1_epi32(7 << 16);
+  const __m256i bias = _mm256_set1_epi16(3);
+
+  for (size_t i = 0; i < prf.size() / 24; i++) {
+    const uint8_t* const src = prf.data() + (i * 24);
+
+    const __m128i b_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 0)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i b_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 8)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    __m256i f0 = _mm256_shuffle_epi8(_mm256_set_m128i(b_hi, b_lo), idx);
+    const __m256i f1 = _mm256_and_si256(_mm256_srli_epi32(f0, 1), mask249);
+    const __m256i f2 = _mm256_and_si256(_mm256_srli_epi32(f0, 2), mask249);
+    f0 = _mm256_add_epi32(_mm256_add_epi32(_mm256_and_si256(f0, mask249), f1), f2);
+
+    // Bits [0, 3), [6, 9), [12, 15) and [18, 21) hold (sum of a bit triple) + 3 - (sum of the next bit triple).
+    f0 = _mm256_sub_epi32(_mm256_add_epi32(f0, mask6db), _mm256_srli_epi32(f0, 3));
+
+    // 16 -bit lanes of `c01` hold coefficients 0, 1 and of `c23` hold coefficients 2, 3, of each 24 -bit word.
+    const __m256i c01 = _mm256_sub_epi16(_mm256_add_epi16(_mm256_and_si256(f0, mask07), _mm256_and_si256(_mm256_slli_epi32(f0, 10), mask70)), bias);
+    const __m256i c23 = _mm256_sub_epi16(_mm256_add_epi16(_mm256_and_si256(_mm256_srli_epi32(f0, 12), mask07), _mm256_and_si256(_mm256_srli_epi32(f0, 2), mask70)), bias);
+
+    const __m256i c0 = _mm256_unpacklo_epi32(c01, c23);
+    const __m256i c1 = _mm256_unpackhi_epi32(c01, c23);
+
+    int16_t* const dst = poly.data() + (i * 32);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 0), _mm256_permute2x128_si256(c0, c1, 0x20));  // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 16), _mm256_permute2x128_si256(c0, c1, 0x31)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+
+}
+#endif
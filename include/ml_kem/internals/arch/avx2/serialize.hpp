@@ -0,0 +1,243 @@
+#pragma once
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include "ml_kem/internals/arch/avx2/ntt.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <immintrin.h>
+#include <span>
+
+// AVX2 implementation of serialization of polynomials with signed 16 -bit coefficients, for each l ∈ {1, 4, 5, 10, 11, 12}, packing
+// ( or unpacking ) 16 coefficients of l bits each, to ( or from ) 2 x l bytes, at a time.
+namespace ml_kem_utils::avx2 {
+
+// Number of coefficients packed ( or unpacked ) in a single step.
+inline constexpr size_t SERIALIZE_STEP = 16;
+
+// Width of a 128 -bit register, in bytes.
+inline constexpr size_t XMM_BYTES = 16;
+
+// For unpacking 8 coefficients of l bits each, from l bytes, which are broadcast to both 128 -bit halves of a register, coefficient j
+// ( 4 of them in each half ) is gathered into 32 -bit lane j, from 4 bytes starting at byte ⌊(j * l) / 8⌋.
+template<size_t l>
+constexpr std::array<uint8_t, 32>
+make_unpack_shuffle()
+{
+  std::array<uint8_t, 32> res{};
+
+  for (size_t j = 0; j < 8; j++) {
+    const size_t boff = (j * l) / 8;
+
+    for (size_t b = 0; b < 4; b++) {
+      res[(j * 4) + b] = static_cast<uint8_t>(boff + b);
+    }
+  }
+
+  return res;
+}
+
+// Right shift of 32 -bit lane j, which brings coefficient j, gathered using above shuffle, to the least significant bit.
+template<size_t l>
+constexpr std::array<int32_t, 8>
+make_unpack_shifts()
+{
+  std::array<int32_t, 8> res{};
+
+  for (size_t j = 0; j < res.size(); j++) {
+    res[j] = static_cast<int32_t>((j * l) % 8);
+  }
+
+  return res;
+}
+
+template<size_t l>
+inline constexpr auto UNPACK_SHUFFLE = make_unpack_shuffle<l>();
+
+template<size_t l>
+inline constexpr auto UNPACK_SHIFTS = make_unpack_shifts<l>();
+
+// Given 16 coefficients, each ∈ [0, 2^l), this routine packs them s.t. each 128 -bit half of the result holds 8 coefficients, in its
+// lowest l bytes, same as scalar `encode` lays them out. Adjacent coefficients are first merged into 32 -bit lanes of 2l bits, then into
+// 64 -bit lanes of 4l bits and finally into 128 -bit lanes of 8l bits.
+template<size_t l>
+ML_KEM_TARGET_AVX2 inline __m256i
+pack(const __m256i a)
+{
+  constexpr int sh32 = 32 - (2 * static_cast<int>(l));
+  constexpr int sh64 = 4 * static_cast<int>(l);
+
+  const __m256i mul = _mm256_set1_epi32(static_cast<int32_t>((1U << (l + 16)) | 1U));
+  const __m256i x32 = _mm256_madd_epi16(a, mul);
+
+  const __m256i x64 = _mm256_srli_epi64(_mm256_sllv_epi32(x32, _mm256_setr_epi32(sh32, 0, sh32, 0, sh32, 0, sh32, 0)), sh32);
+
+  const __m256i lo = _mm256_sllv_epi64(x64, _mm256_setr_epi64x(0, sh64, 0, sh64));
+  const __m256i hi = _mm256_srlv_epi64(x64, _mm256_setr_epi64x(64, 64 - sh64, 64, 64 - sh64));
+
+  return _mm256_or_si256(_mm256_unpacklo_epi64(lo, _mm256_setzero_si256()), _mm256_unpackhi_epi64(lo, hi));
+}
+
+// Given a degree-255 polynomial with signed 16 -bit coefficients, this routine maps each coefficient to l bits, using `map_t::apply`,
+// 16 lanes at a time, and serializes them to a byte array of length 32 * l -bytes, laid out same as the portable `encode<l>` does. When
+// l = 1, 32 coefficients are serialized at a time, by collecting their lowest bits using byte mask extraction.
+template<size_t l, typename map_t>
+ML_KEM_TARGET_AVX2 inline void
+encode_mapped(std::span<const int16_t, ml_kem_ntt::N> poly, std::span<uint8_t, 32 * l> arr)
+{
+  using ml_kem_ntt::avx2::load;
+
+  if constexpr (l == 1) {
+    for (size_t i = 0; i < poly.size() / 32; i++) {
+      const __m256i a = _mm256_slli_epi16(map_t::apply(load(poly.data() + (i * 32) + 0)), 15);
+      const __m256i b = _mm256_slli_epi16(map_t::apply(load(poly.data() + (i * 32) + 16)), 15);
+
+      const __m256i bytes = _mm256_permute4x64_epi64(_mm256_packs_epi16(a, b), 0xd8);
+      const auto bits = static_cast<uint32_t>(_mm256_movemask_epi8(bytes));
+
+      std::memcpy(arr.data() + (i * sizeof(bits)), &bits, sizeof(bits));
+    }
+  } else {
+    constexpr size_t step_bytes = 2 * l;
+
+    for (size_t i = 0; i < poly.size() / SERIALIZE_STEP; i++) {
+      const __m256i p = pack<l>(map_t::apply(load(poly.data() + (i * SERIALIZE_STEP))));
+
+      uint8_t* const dst = arr.data() + (i * step_bytes);
+
+      // Each 128 -bit store spills past the l bytes it carries, which is fine as long as spilled bytes are overwritten by a later
+      // store; the last few steps go through a buffer instead, so that nothing is written past end of `arr`.
+      if ((i * step_bytes) + l + XMM_BYTES <= arr.size()) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst), _mm256_castsi256_si128(p));          // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + l), _mm256_extracti128_si256(p, 1)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+      } else {
+        std::array<uint8_t, l + XMM_BYTES> buf{};
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buf.data()), _mm256_castsi256_si128(p));          // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(buf.data() + l), _mm256_extracti128_si256(p, 1)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::memcpy(dst, buf.data(), step_bytes);
+      }
+    }
+  }
+}
+
+// Given l bytes, broadcast to both 128 -bit halves, this routine unpacks 8 coefficients of l bits each, into 32 -bit lanes.
+template<size_t l>
+ML_KEM_TARGET_AVX2 inline __m256i
+unpack(const __m128i bytes)
+{
+  const __m256i shuf = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(UNPACK_SHUFFLE<l>.data())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  const __m256i shifts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(UNPACK_SHIFTS<l>.data())); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  const __m256i mask = _mm256_set1_epi32(static_cast<int32_t>((1U << l) - 1U));
+
+  const __m256i x = _mm256_shuffle_epi8(_mm256_broadcastsi128_si256(bytes), shuf);
+  return _mm256_and_si256(_mm256_srlv_epi32(x, shifts), mask);
+}
+
+// Given a byte array of length 32 * l -bytes, laid out same as the portable `encode<l>` does, this routine deserializes it to 256
+// coefficients of l bits each, 16 lanes at a time, mapping each of them using `map.apply`, into a degree-255 polynomial with signed
+// 16 -bit coefficients. The map may carry state across steps, such as an accumulated check.
+template<size_t l, typename map_t>
+ML_KEM_TARGET_AVX2 inline void
+decode_mapped(std::span<const uint8_t, 32 * l> arr, std::span<int16_t, ml_kem_ntt::N> poly, map_t& map)
+{
+  constexpr size_t step_bytes = 2 * l;
+
+  // Each 128 -bit load reads past the l bytes it needs; the last few steps read from a zero padded copy instead, so that nothing is
+  // read past end of `arr`.
+  std::array<uint8_t, l + XMM_BYTES> buf{};
+
+  for (size_t i = 0; i < poly.size() / SERIALIZE_STEP; i++) {
+    const uint8_t* src = arr.data() + (i * step_bytes);
+
+    if ((i * step_bytes) + l + XMM_BYTES > arr.size()) {
+      std::memcpy(buf.data(), src, step_bytes);
+      src = buf.data();
+    }
+
+    const __m128i b0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));     // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    const __m128i b1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + l)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+    // 32 -bit lanes are packed to 16 -bit lanes, with 128 -bit halves interleaved, which are put back in order.
+    const __m256i c = _mm256_permute4x64_epi64(_mm256_packs_epi32(unpack<l>(b0), unpack<l>(b1)), 0xd8);
+
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(poly.data() + (i * SERIALIZE_STEP)), map.apply(c)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  }
+}
+
+// Fully reduces each coefficient and keeps its lowest l bits, as the portable `encode<l>` does.
+template<size_t l>
+struct reduce_bits_t
+{
+  ML_KEM_TARGET_AVX2 static __m256i apply(const __m256i a)
+  {
+    const __m256i mask = _mm256_set1_epi16(static_cast<int16_t>((1U << l) - 1U));
+    return _mm256_and_si256(ml_kem_ntt::avx2::canonicalize(ml_kem_ntt::avx2::barrett_reduce(a)), mask);
+  }
+};
+
+// Reduces each decoded coefficient modulo q, when l = 12, as the portable `decode<l>` does. Otherwise coefficients are kept as they are.
+template<size_t l>
+struct decoded_bits_t
+{
+  ML_KEM_TARGET_AVX2 static __m256i apply(const __m256i a)
+  {
+    if constexpr (l == 12) {
+      return _mm256_min_epu16(a, _mm256_sub_epi16(a, _mm256_set1_epi16(ml_kem_ntt::avx2::Q)));
+    } else {
+      return a;
+    }
+  }
+};
+
+// Given a degree-255 polynomial with signed 16 -bit coefficients, this routine serializes it to a byte array of length 32 * l -bytes,
+// producing same bytes as the portable `encode<l>` does, i.e. each coefficient is first fully reduced and then its lowest l bits are
+// serialized.
+template<size_t l>
+ML_KEM_TARGET_AVX2 inline void
+encode(std::span<const int16_t, ml_kem_ntt::N> poly, std::span<uint8_t, 32 * l> arr)
+{
+  encode_mapped<l, reduce_bits_t<l>>(poly, arr);
+}
+
+// Given a byte array of length 32 * l -bytes, this routine deserializes it to a degree-255 polynomial with signed 16 -bit coefficients,
+// producing same coefficients as the portable `decode<l>` does, i.e. each ∈ [0, 2^l), which are also reduced modulo q, when l = 12.
+template<size_t l>
+ML_KEM_TARGET_AVX2 inline void
+decode(std::span<const uint8_t, 32 * l> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  decoded_bits_t<l> map{};
+  decode_mapped<l>(arr, poly, map);
+}
+
+// Reduces each decoded 12 -bit coefficient modulo q, while accumulating a mask of lanes which held a coefficient ≥ q.
+struct checked_bits_t
+{
+  __m256i non_canonical{};
+
+  ML_KEM_TARGET_AVX2 __m256i apply(const __m256i a)
+  {
+    const __m256i q = _mm256_set1_epi16(ml_kem_ntt::avx2::Q);
+
+    non_canonical = _mm256_or_si256(non_canonical, _mm256_cmpgt_epi16(a, _mm256_set1_epi16(ml_kem_ntt::avx2::Q - 1)));
+    return _mm256_min_epu16(a, _mm256_sub_epi16(a, q));
+  }
+};
+
+// Given a byte array of length 32 * 12 -bytes, this routine deserializes it to a degree-255 polynomial with canonical signed 16 -bit
+// coefficients, same as `decode<12>` does, while also checking, in the same pass, whether any of the decoded 12 -bit coefficients is ≥ q.
+// Returns a non-zero byte mask if so, otherwise 0.
+ML_KEM_TARGET_AVX2 inline uint32_t
+decode_checked(std::span<const uint8_t, 32 * 12> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  checked_bits_t map{};
+  decode_mapped<12>(arr, poly, map);
+
+  return static_cast<uint32_t>(_mm256_movemask_epi8(map.non_canonical));
+}
+
+}
+#endif
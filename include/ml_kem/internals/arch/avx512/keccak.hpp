@@ -0,0 +1,73 @@
+#pragma once
+#include "ml_kem/internals/keccak/keccak.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// GCC 12 ( see https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593 ) reports self-initialized `_mm512_undefined_*()` values, used
+// inside many AVX-512 intrinsics, as uninitialized, once they are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+// AVX-512 implementation of Keccak-f[1600] permutation, applied on 8 independent states at once.
+namespace ml_kem_keccak::avx512 {
+
+// Number of Keccak-f[1600] states, which are permuted together.
+inline constexpr size_t LANES = 8;
+
+// Given 8 interleaved Keccak-f[1600] states s.t. lane i of state j lives at index i * 8 + j, this routine applies all 24 rounds of
+// the permutation on each of them, in-place. Each state lane is kept in a 512 -bit register, while χ step's a ^ (~b & c) and θ step's
+// three-way xors are computed using a single `vpternlogq` instruction.
+ML_KEM_TARGET_AVX512 inline void
+permute_x8(std::span<uint64_t, LANE_CNT * LANES> state)
+{
+  __m512i a[LANE_CNT]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  __m512i b[LANE_CNT]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  __m512i c[5];        // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    a[i] = _mm512_loadu_si512(state.data() + (i * LANES));
+  }
+
+  for (size_t r = 0; r < NUM_ROUNDS; r++) {
+    // θ
+    for (size_t x = 0; x < 5; x++) {
+      const __m512i t = _mm512_ternarylogic_epi64(a[x], a[x + 5], a[x + 10], 0x96);
+      c[x] = _mm512_ternarylogic_epi64(t, a[x + 15], a[x + 20], 0x96);
+    }
+    for (size_t x = 0; x < 5; x++) {
+      const __m512i d = _mm512_xor_si512(c[(x + 4) % 5], _mm512_rolv_epi64(c[(x + 1) % 5], _mm512_set1_epi64(1)));
+      for (size_t y = 0; y < 5; y++) {
+        a[x + 5 * y] = _mm512_xor_si512(a[x + 5 * y], d);
+      }
+    }
+
+    // ρ and π
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      b[PI_INDICES[i]] = _mm512_rolv_epi64(a[i], _mm512_set1_epi64(ROTATION_OFFSETS[i]));
+    }
+
+    // χ
+    for (size_t y = 0; y < 5; y++) {
+      for (size_t x = 0; x < 5; x++) {
+        a[x + 5 * y] = _mm512_ternarylogic_epi64(b[x + 5 * y], b[((x + 1) % 5) + 5 * y], b[((x + 2) % 5) + 5 * y], 0xD2);
+      }
+    }
+
+    // ι
+    a[0] = _mm512_xor_si512(a[0], _mm512_set1_epi64(static_cast<int64_t>(ROUND_CONSTANTS[r])));
+  }
+
+  for (size_t i = 0; i < LANE_CNT; i++) {
+    _mm512_storeu_si512(state.data() + (i * LANES), a[i]);
+  }
+}
+
+}
+
+#pragma GCC diagnostic pop
+#endif
@@ -0,0 +1,490 @@
+#pragma once
+#include "ml_kem/internals/arch/avx2/ntt.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
+
+#if ML_KEM_X86_SIMD
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+#include <span>
+
+// AVX-512 implementation of NTT, iNTT and polynomial multiplication in NTT domain, operating on 32 lanes of 16 -bit coefficients.
+//
+// Follows the same structure as the AVX2 implementation ( see `ml_kem_ntt::avx2` ), whose per-lane twiddle factor generators are
+// reused. Wider registers mean one more layer is computed within a pair of registers, while only three layers operate
+// on whole registers. Requires AVX-512F and AVX-512BW.
+// GCC 12 ( see https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593 ) reports self-initialized `_mm512_undefined_*()` values, used
+// inside many AVX-512 intrinsics, as uninitialized, once they are inlined.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+namespace ml_kem_ntt::avx512 {
+
+using ml_kem_field::BARRETT_V;
+using ml_kem_field::mul_qinv;
+using ml_kem_field::QINV;
+using ml_kem_field::R2_MOD_Q;
+using ml_kem_field::twiddle_t;
+
+inline constexpr int16_t Q = ml_kem_field::Q16;
+
+inline constexpr auto NTT_LANE_TWIDDLES = avx2::make_lane_twiddles<false, 32>();
+inline constexpr auto INTT_LANE_TWIDDLES = avx2::make_lane_twiddles<true, 32>();
+inline constexpr auto NTT_REG_TWIDDLES = avx2::make_reg_twiddles<false, 6>();
+inline constexpr auto INTT_REG_TWIDDLES = avx2::make_reg_twiddles<true, 6>();
+inline constexpr auto BASEMUL_LANE_TWIDDLES = avx2::make_basemul_lane_twiddles<32>();
+
+ML_KEM_TARGET_AVX512 inline __m512i
+load(const int16_t* const ptr)
+{
+  return _mm512_loadu_si512(ptr);
+}
+
+ML_KEM_TARGET_AVX512 inline void
+store(int16_t* const ptr, const __m512i v)
+{
+  _mm512_storeu_si512(ptr, v);
+}
+
+// Montgomery multiplication of each lane of `a` with corresponding lane of `b`, where `b_qinv` = b * q^-1 mod 2^16.
+// Computes a * b * 2^-16 mod q, as a representative ∈ (-q, q), given that |a * b| < q * 2^15.
+ML_KEM_TARGET_AVX512 inline __m512i
+fqmul(const __m512i a, const __m512i b, const __m512i b_qinv)
+{
+  const __m512i lo = _mm512_mullo_epi16(a, b_qinv);
+  const __m512i hi = _mm512_mulhi_epi16(a, b);
+  const __m512i t = _mm512_mulhi_epi16(lo, _mm512_set1_epi16(Q));
+
+  return _mm512_sub_epi16(hi, t);
+}
+
+// Same as above, but when b * q^-1 is not precomputed.
+ML_KEM_TARGET_AVX512 inline __m512i
+fqmul(const __m512i a, const __m512i b)
+{
+  return fqmul(a, b, _mm512_mullo_epi16(b, _mm512_set1_epi16(QINV)));
+}
+
+// Barrett reduction of each signed 16 -bit lane, producing a representative ∈ [-q, 2q).
+ML_KEM_TARGET_AVX512 inline __m512i
+barrett_reduce(const __m512i a)
+{
+  const __m512i t0 = _mm512_mulhi_epi16(a, _mm512_set1_epi16(BARRETT_V));
+  const __m512i t1 = _mm512_srai_epi16(t0, 10);
+  const __m512i t2 = _mm512_mullo_epi16(t1, _mm512_set1_epi16(Q));
+
+  return _mm512_sub_epi16(a, t2);
+}
+
+// Given signed 16 -bit lanes, each ∈ [-q, 2q), this routine computes canonical representative ∈ [0, q).
+ML_KEM_TARGET_AVX512 inline __m512i
+canonicalize(const __m512i a)
+{
+  const __m512i q = _mm512_set1_epi16(Q);
+
+  const __m512i t0 = _mm512_mask_add_epi16(a, _mm512_cmplt_epi16_mask(a, _mm512_setzero_si512()), a, q);
+  const __m512i t1 = _mm512_mask_sub_epi16(t0, _mm512_cmpge_epi16_mask(t0, q), t0, q);
+
+  return t1;
+}
+
+// Cooley-Tukey butterfly, used in forward NTT.
+ML_KEM_TARGET_AVX512 inline void
+ct_butterfly(__m512i& a, __m512i& b, const __m512i zeta, const __m512i zeta_qinv)
+{
+  const __m512i t = fqmul(b, zeta, zeta_qinv);
+
+  b = _mm512_sub_epi16(a, t);
+  a = _mm512_add_epi16(a, t);
+}
+
+// Gentleman-Sande butterfly, used in inverse NTT.
+ML_KEM_TARGET_AVX512 inline void
+gs_butterfly(__m512i& a, __m512i& b, const __m512i zeta, const __m512i zeta_qinv)
+{
+  const __m512i t = _mm512_sub_epi16(a, b);
+
+  a = _mm512_add_epi16(a, b);
+  b = fqmul(t, zeta, zeta_qinv);
+}
+
+// Following four routines shuffle a pair of registers, such that lanes, which are `len` = 16, 8, 4 and 2 coefficients apart, are
+// placed in the same lane of two registers. Each of them is an involution, so applying it twice restores the original layout.
+ML_KEM_TARGET_AVX512 inline void
+shuffle16(__m512i& a, __m512i& b)
+{
+  const __m512i t0 = _mm512_shuffle_i64x2(a, b, 0b01000100);
+  const __m512i t1 = _mm512_shuffle_i64x2(a, b, 0b11101110);
+
+  a = t0;
+  b = t1;
+}
+
+ML_KEM_TARGET_AVX512 inline void
+shuffle8(__m512i& a, __m512i& b)
+{
+  const __m512i t0 = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(0, 1, 8, 9, 4, 5, 12, 13), b);
+  const __m512i t1 = _mm512_permutex2var_epi64(a, _mm512_setr_epi64(2, 3, 10, 11, 6, 7, 14, 15), b);
+
+  a = t0;
+  b = t1;
+}
+
+ML_KEM_TARGET_AVX512 inline void
+shuffle4(__m512i& a, __m512i& b)
+{
+  const __m512i t0 = _mm512_unpacklo_epi64(a, b);
+  const __m512i t1 = _mm512_unpackhi_epi64(a, b);
+
+  a = t0;
+  b = t1;
+}
+
+ML_KEM_TARGET_AVX512 inline void
+shuffle2(__m512i& a, __m512i& b)
+{
+  const __m512i t0 = _mm512_mask_blend_epi32(0b1010101010101010, a, _mm512_slli_epi64(b, 32));
+  const __m512i t1 = _mm512_mask_blend_epi32(0b1010101010101010, _mm512_srli_epi64(a, 32), b);
+
+  a = t0;
+  b = t1;
+}
+
+// Separates even and odd 16 -bit lanes of a pair of registers ( and it's also an involution ).
+ML_KEM_TARGET_AVX512 inline void
+shuffle1(__m512i& a, __m512i& b)
+{
+  const __m512i t0 = _mm512_mask_blend_epi16(0xAAAAAAAAU, a, _mm512_slli_epi32(b, 16));
+  const __m512i t1 = _mm512_mask_blend_epi16(0xAAAAAAAAU, _mm512_srli_epi32(a, 16), b);
+
+  a = t0;
+  b = t1;
+}
+
+// Converts 256 canonical coefficients of a polynomial to 16 -bit lanes.
+ML_KEM_TARGET_AVX512 inline void
+pack(std::span<const ml_kem_field::zq_t, N> src, std::span<int16_t, N> dst)
+{
+  for (size_t i = 0; i < N; i += 32) {
+    const __m256i lo = _mm512_cvtepi32_epi16(_mm512_loadu_si512(src.data() + i));
+    const __m256i hi = _mm512_cvtepi32_epi16(_mm512_loadu_si512(src.data() + i + 16));
+
+    store(dst.data() + i, _mm512_inserti64x4(_mm512_castsi256_si512(lo), hi, 1));
+  }
+}
+
+// Converts 256 canonical coefficients, held in 16 -bit lanes, back to `zq_t` form.
+ML_KEM_TARGET_AVX512 inline void
+unpack(std::span<const int16_t, N> src, std::span<ml_kem_field::zq_t, N> dst)
+{
+  for (size_t i = 0; i < N; i += 32) {
+    const __m512i v = load(src.data() + i);
+
+    _mm512_storeu_si512(dst.data() + i, _mm512_cvtepu16_epi32(_mm512_castsi512_si256(v)));
+    _mm512_storeu_si512(dst.data() + i + 16, _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(v, 1)));
+  }
+}
+
+// Butterflies with a single twiddle factor, broadcasted to all lanes, or with per-lane twiddle factors.
+ML_KEM_TARGET_AVX512 inline void
+ct_butterfly(__m512i& a, __m512i& b, const twiddle_t tw)
+{
+  ct_butterfly(a, b, _mm512_set1_epi16(tw.zeta), _mm512_set1_epi16(tw.zeta_qinv));
+}
+
+ML_KEM_TARGET_AVX512 inline void
+ct_butterfly(__m512i& a, __m512i& b, const avx2::lane_twiddles_t<32>& tw)
+{
+  ct_butterfly(a, b, load(tw.zeta.data()), load(tw.zeta_qinv.data()));
+}
+
+ML_KEM_TARGET_AVX512 inline void
+gs_butterfly(__m512i& a, __m512i& b, const twiddle_t tw)
+{
+  gs_butterfly(a, b, _mm512_set1_epi16(tw.zeta), _mm512_set1_epi16(tw.zeta_qinv));
+}
+
+ML_KEM_TARGET_AVX512 inline void
+gs_butterfly(__m512i& a, __m512i& b, const avx2::lane_twiddles_t<32>& tw)
+{
+  gs_butterfly(a, b, load(tw.zeta.data()), load(tw.zeta_qinv.data()));
+}
+
+// Forward NTT over 16 -bit lanes. Input coefficients must be ∈ (-q, q), output coefficients are ∈ [0, q), in bit-reversed order.
+//
+// Whole polynomial fits in eight registers, so all seven layers are computed in a single pass over it.
+ML_KEM_TARGET_AVX512 inline void
+ntt(std::span<int16_t, N> poly)
+{
+  __m512i r[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  for (size_t i = 0; i < 8; i++) {
+    r[i] = load(poly.data() + i * 32);
+  }
+
+  // Layers with len = 128, 64, where butterflies operate on whole registers.
+  const auto& tw = NTT_REG_TWIDDLES;
+
+  ct_butterfly(r[0], r[4], tw[0]);
+  ct_butterfly(r[1], r[5], tw[0]);
+  ct_butterfly(r[2], r[6], tw[0]);
+  ct_butterfly(r[3], r[7], tw[0]);
+
+  ct_butterfly(r[0], r[2], tw[1]);
+  ct_butterfly(r[1], r[3], tw[1]);
+  ct_butterfly(r[4], r[6], tw[2]);
+  ct_butterfly(r[5], r[7], tw[2]);
+
+  // Layers with len = 32, 16, 8, 4, 2, computed on each pair of registers, holding 64 consecutive coefficients.
+  for (size_t pair = 0; pair < 4; pair++) {
+    const auto& ltw = NTT_LANE_TWIDDLES[pair];
+
+    __m512i& a = r[2 * pair];
+    __m512i& b = r[2 * pair + 1];
+
+    ct_butterfly(a, b, ltw[0]);
+    shuffle16(a, b);
+    ct_butterfly(a, b, ltw[1]);
+    shuffle8(a, b);
+    ct_butterfly(a, b, ltw[2]);
+    shuffle4(a, b);
+    ct_butterfly(a, b, ltw[3]);
+    shuffle2(a, b);
+    ct_butterfly(a, b, ltw[4]);
+
+    shuffle2(a, b);
+    shuffle4(a, b);
+    shuffle8(a, b);
+    shuffle16(a, b);
+  }
+
+  // Each coefficient is now ∈ (-8q, 8q).
+  for (size_t i = 0; i < 8; i++) {
+    store(poly.data() + i * 32, canonicalize(barrett_reduce(r[i])));
+  }
+}
+
+// Inverse NTT over 16 -bit lanes. Input coefficients must be ∈ (-q, q), in bit-reversed order, output coefficients are ∈ [0, q).
+//
+// Computed in a single pass, same as forward NTT. Sums are reduced after layers with len = 8 and len = 32, following the schedule
+// proven by `ml_kem_ntt::scalar::intt`, while scaling by N^-1 is folded into the last layer.
+ML_KEM_TARGET_AVX512 inline void
+intt(std::span<int16_t, N> poly)
+{
+  __m512i r[8]; // NOLINT(cppcoreguidelines-avoid-c-arrays,hicpp-avoid-c-arrays,modernize-avoid-c-arrays)
+  for (size_t i = 0; i < 8; i++) {
+    r[i] = load(poly.data() + i * 32);
+  }
+
+  // Layers with len = 2, 4, 8, 16, 32, computed on each pair of registers, holding 64 consecutive coefficients.
+  for (size_t pair = 0; pair < 4; pair++) {
+    const auto& ltw = INTT_LANE_TWIDDLES[pair];
+
+    __m512i& a = r[2 * pair];
+    __m512i& b = r[2 * pair + 1];
+
+    shuffle16(a, b);
+    shuffle8(a, b);
+    shuffle4(a, b);
+    shuffle2(a, b);
+
+    gs_butterfly(a, b, ltw[0]);
+    shuffle2(a, b);
+    gs_butterfly(a, b, ltw[1]);
+    shuffle4(a, b);
+    gs_butterfly(a, b, ltw[2]);
+    a = barrett_reduce(a);
+    shuffle8(a, b);
+    gs_butterfly(a, b, ltw[3]);
+    shuffle16(a, b);
+    gs_butterfly(a, b, ltw[4]);
+    a = barrett_reduce(a);
+  }
+
+  // Layers with len = 64, 128, where butterflies operate on whole registers.
+  const auto& tw = INTT_REG_TWIDDLES;
+
+  gs_butterfly(r[0], r[2], tw[0]);
+  gs_butterfly(r[1], r[3], tw[0]);
+  gs_butterfly(r[4], r[6], tw[1]);
+  gs_butterfly(r[5], r[7], tw[1]);
+
+  // Last layer, whose twiddle factor is already scaled by N^-1, while sums are scaled explicitly.
+  const __m512i inv_n = _mm512_set1_epi16(INV_N_TWIDDLE.zeta);
+  const __m512i inv_n_qinv = _mm512_set1_epi16(INV_N_TWIDDLE.zeta_qinv);
+
+  for (size_t i = 0; i < 4; i++) {
+    gs_butterfly(r[i], r[i + 4], tw[2]);
+    r[i] = fqmul(r[i], inv_n, inv_n_qinv);
+  }
+
+  for (size_t i = 0; i < 8; i++) {
+    store(poly.data() + i * 32, canonicalize(r[i]));
+  }
+}
+
+// Given two polynomials in NTT domain, with coefficients ∈ (-q, q) held in 16 -bit lanes, this routine computes 128 base case
+// multiplications of degree-1 polynomials, writing canonical coefficients of product polynomial to `h`.
+ML_KEM_TARGET_AVX512 inline void
+polymul(std::span<const int16_t, N> f, std::span<const int16_t, N> g, std::span<int16_t, N> h)
+{
+  const __m512i r2 = _mm512_set1_epi16(R2_MOD_Q);
+  const __m512i r2_qinv = _mm512_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t pair = 0; pair < 4; pair++) {
+    const size_t off = pair * 64;
+
+    __m512i f0 = load(f.data() + off);
+    __m512i f1 = load(f.data() + off + 32);
+    __m512i g0 = load(g.data() + off);
+    __m512i g1 = load(g.data() + off + 32);
+
+    shuffle1(f0, f1);
+    shuffle1(g0, g1);
+
+    const __m512i zeta = load(BASEMUL_LANE_TWIDDLES[pair].zeta.data());
+    const __m512i zeta_qinv = load(BASEMUL_LANE_TWIDDLES[pair].zeta_qinv.data());
+
+    // h0 = f0 * g0 + f1 * g1 * ζ and h1 = f0 * g1 + f1 * g0, all scaled by 2^-16, each ∈ (-2q, 2q).
+    const __m512i t0 = fqmul(fqmul(f1, g1), zeta, zeta_qinv);
+    __m512i h0 = _mm512_add_epi16(fqmul(f0, g0), t0);
+    __m512i h1 = _mm512_add_epi16(fqmul(f0, g1), fqmul(f1, g0));
+
+    h0 = canonicalize(fqmul(h0, r2, r2_qinv));
+    h1 = canonicalize(fqmul(h1, r2, r2_qinv));
+
+    shuffle1(h0, h1);
+
+    store(h.data() + off, h0);
+    store(h.data() + off + 32, h1);
+  }
+}
+
+// Montgomery reduction of each signed 32 -bit lane, leaving result in its upper 16 -bit half ( see `avx2::montgomery_reduce` ).
+ML_KEM_TARGET_AVX512 inline __m512i
+montgomery_reduce(const __m512i a)
+{
+  const __m512i t = _mm512_mullo_epi16(a, _mm512_set1_epi16(QINV));
+  const __m512i tq = _mm512_mulhi_epi16(t, _mm512_set1_epi16(Q));
+
+  return _mm512_sub_epi16(a, _mm512_slli_epi32(tq, 16));
+}
+
+// Sum of products of `cnt` pairs of polynomials in NTT domain, accumulated in 32 -bit lanes ( see `avx2::polymul_acc` ).
+template<size_t cnt>
+ML_KEM_TARGET_AVX512 inline void
+polymul_acc(std::span<const int16_t, cnt * N> f, std::span<const int16_t, cnt * N> g, std::span<int16_t, N> h)
+{
+  constexpr __mmask32 odd = 0xAAAAAAAAU;
+
+  const __m512i r2 = _mm512_set1_epi16(R2_MOD_Q);
+  const __m512i r2_qinv = _mm512_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t off = 0; off < N; off += 32) {
+    const __m512i zeta = load(avx2::BASEMUL_PAIR_ZETAS.data() + off);
+
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+
+    for (size_t i = 0; i < cnt; i++) {
+      const __m512i fv = load(f.data() + i * N + off);
+      const __m512i gv = load(g.data() + i * N + off);
+
+      // (f0, f1 * g1 * 2^-16) . (g0, ζ * 2^16)
+      const __m512i t0 = _mm512_mask_blend_epi16(odd, fv, fqmul(fv, gv));
+      const __m512i t1 = _mm512_mask_blend_epi16(odd, gv, zeta);
+      acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(t0, t1));
+
+      // (f0, f1) . (g1, g0)
+      const __m512i gs = _mm512_or_si512(_mm512_slli_epi32(gv, 16), _mm512_srli_epi32(gv, 16));
+      acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(fv, gs));
+    }
+
+    const __m512i h0 = _mm512_srli_epi32(montgomery_reduce(acc0), 16);
+    const __m512i h1 = montgomery_reduce(acc1);
+
+    store(h.data() + off, canonicalize(fqmul(_mm512_mask_blend_epi16(odd, h0, h1), r2, r2_qinv)));
+  }
+}
+
+// Sum of products of `cnt` pairs of polynomials in NTT domain, using multiplication cache of each of g_i ( see
+// `avx2::polymul_acc` ).
+template<size_t cnt>
+ML_KEM_TARGET_AVX512 inline void
+polymul_acc(std::span<const int16_t, cnt * N> f,
+            std::span<const int16_t, cnt * N> g,
+            std::span<const int16_t, cnt * N / 2> g_cache,
+            std::span<int16_t, N> h)
+{
+  constexpr __mmask32 odd = 0xAAAAAAAAU;
+
+  const __m512i r2 = _mm512_set1_epi16(R2_MOD_Q);
+  const __m512i r2_qinv = _mm512_set1_epi16(mul_qinv(R2_MOD_Q));
+
+  for (size_t off = 0; off < N; off += 32) {
+    __m512i acc0 = _mm512_setzero_si512();
+    __m512i acc1 = _mm512_setzero_si512();
+
+    for (size_t i = 0; i < cnt; i++) {
+      const __m512i fv = load(f.data() + i * N + off);
+      const __m512i gv = load(g.data() + i * N + off);
+      const __m256i cv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(g_cache.data() + i * (N / 2) + off / 2)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+      // (f0, f1) . (g0, g1 * ζ)
+      const __m512i t = _mm512_mask_blend_epi16(odd, gv, _mm512_slli_epi32(_mm512_cvtepu16_epi32(cv), 16));
+      acc0 = _mm512_add_epi32(acc0, _mm512_madd_epi16(fv, t));
+
+      // (f0, f1) . (g1, g0)
+      const __m512i gs = _mm512_or_si512(_mm512_slli_epi32(gv, 16), _mm512_srli_epi32(gv, 16));
+      acc1 = _mm512_add_epi32(acc1, _mm512_madd_epi16(fv, gs));
+    }
+
+    const __m512i h0 = _mm512_srli_epi32(montgomery_reduce(acc0), 16);
+    const __m512i h1 = montgomery_reduce(acc1);
+
+    store(h.data() + off, canonicalize(fqmul(_mm512_mask_blend_epi16(odd, h0, h1), r2, r2_qinv)));
+  }
+}
+
+// Forward NTT over polynomial with `zq_t` coefficients, producing bit-identical result as `ml_kem_ntt::scalar::ntt`.
+ML_KEM_TARGET_AVX512 inline void
+ntt(std::span<ml_kem_field::zq_t, N> poly)
+{
+  alignas(64) std::array<int16_t, N> buf{};
+
+  pack(poly, buf);
+  ntt(std::span(buf));
+  unpack(buf, poly);
+}
+
+// Inverse NTT over polynomial with `zq_t` coefficients, producing bit-identical result as `ml_kem_ntt::scalar::intt`.
+ML_KEM_TARGET_AVX512 inline void
+intt(std::span<ml_kem_field::zq_t, N> poly)
+{
+  alignas(64) std::array<int16_t, N> buf{};
+
+  pack(poly, buf);
+  intt(std::span(buf));
+  unpack(buf, poly);
+}
+
+// Polynomial multiplication in NTT domain, producing bit-identical result as `ml_kem_ntt::scalar::polymul`.
+ML_KEM_TARGET_AVX512 inline void
+polymul(std::span<const ml_kem_field::zq_t, N> f, std::span<const ml_kem_field::zq_t, N> g, std::span<ml_kem_field::zq_t, N> h)
+{
+  alignas(64) std::array<int16_t, N> f_buf{};
+  alignas(64) std::array<int16_t, N> g_buf{};
+  alignas(64) std::array<int16_t, N> h_buf{};
+
+  pack(f, f_buf);
+  pack(g, g_buf);
+  polymul(f_buf, g_buf, h_buf);
+  unpack(h_buf, h);
+}
+
+}
+#pragma GCC diagnostic pop
+#endif
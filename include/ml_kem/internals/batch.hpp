@@ -0,0 +1,783 @@
+#pragma once
+#include "ml_kem/internals/keccak/shake_xn.hpp"
+#include "ml_kem/internals/ml_kem.hpp"
+#include "ml_kem/internals/poly/sampling.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
+#include "ml_kem/internals/utility/params.hpp"
+#include "ml_kem/internals/utility/utils.hpp"
+#include "sha3/sha3_256.hpp"
+#include "sha3/sha3_512.hpp"
+#include "sha3/shake256.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+// Batched Key Encapsulation Mechanism, computing many independent ML-KEM operations per call. Hashing and sampling of up to 8 items is
+// interleaved, s.t. each Keccak-f[1600] permutation is computed on as many independent states at once, as executing CPU allows.
+namespace ml_kem {
+
+// Maximum number of items, which are processed together, in lock-step, by batched routines. It's the number of Keccak-f[1600] states
+// permuted at once by the widest multi-lane permutation, see `ml_kem_keccak::avx512::LANES`.
+inline constexpr size_t BATCH_LANES = 8;
+
+// Pair of 32 -bytes seeds `d` and `z`, from which an ML-KEM keypair is deterministically generated.
+struct seed_pair_t
+{
+  std::array<uint8_t, 32> d{};
+  std::array<uint8_t, 32> z{};
+};
+
+// Caller-supplied workspace of batched routines, holding one workspace ( with fully expanded matrix A ) for each of the items, which
+// are processed together, the secret key, decoded once, for batched decapsulation, which is zeroized before returning, and the cipher
+// text, decoded once, for trial decapsulation under many secret keys. Same as `workspace_t`, it needn't be initialized and can be reused
+// across calls, but it must not be used by more than one call at a time. As it is large, it's better to allocate it on heap.
+template<size_t k>
+struct batch_workspace_t
+{
+  std::array<workspace_t<k, false>, BATCH_LANES> items{};
+  prepared_seckey_t<k> seckey{};
+
+  // Vector u, in NTT domain, and polynomial v of the cipher text. Both are public.
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N> u_prime{};
+  alignas(64) std::array<int16_t, ml_kem_ntt::N> v{};
+};
+
+// Splits first `cnt` items into chunks of `lanes` -many items, invoking `chunk(lanes_t{}, off, len)` for each of them, where `lanes_t`
+// is `std::integral_constant<size_t, lanes>`. A single leftover item is not covered, as it's better processed on its own. Returns number
+// of items, covered by the chunks.
+template<size_t lanes, typename chunk_fn_t>
+inline size_t
+for_each_chunk(const size_t cnt, chunk_fn_t&& chunk)
+{
+  size_t off = 0;
+  while ((cnt - off) > 1) {
+    const size_t len = std::min(lanes, cnt - off);
+    chunk(std::integral_constant<size_t, lanes>{}, off, len);
+    off += len;
+  }
+
+  return off;
+}
+
+// Same as above, but using widest multi-lane Keccak, supported by executing CPU. When none is usable, or `ML_KEM_LOW_STACK` is set, no
+// chunk is processed and it returns 0, s.t. all items are processed one at a time, by the caller.
+template<typename chunk_fn_t>
+inline size_t
+for_each_chunk_xn([[maybe_unused]] const size_t cnt, [[maybe_unused]] chunk_fn_t&& chunk)
+{
+#if ML_KEM_X86_SIMD && !ML_KEM_LOW_STACK
+  if (ml_kem_cpu::has_avx512()) {
+    return for_each_chunk<ml_kem_keccak::avx512::LANES>(cnt, chunk);
+  }
+  if (ml_kem_cpu::has_avx2()) {
+    return for_each_chunk<ml_kem_keccak::avx2::LANES>(cnt, chunk);
+  }
+#endif
+
+  return 0;
+}
+
+// Given `cnt` -many items, s.t. `seed_of(idx)` returns 32 -bytes randomness r of item `idx`, this routine samples noise vectors r and e1
+// and noise polynomial e2 of K-PKE encryption of each item, into `ws.items[idx].pke`, using nonces 0, 1, ..., 2k, in that order. All
+// PRF invocations of all items are computed together, using `lanes` -way Keccak.
+//
+// See line 9-17 of algorithm 14 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t lanes, size_t k, size_t eta1, size_t eta2, typename seed_fn_t>
+inline void
+sample_encrypt_noise_xn(seed_fn_t&& seed_of, const size_t cnt, batch_workspace_t<k>& ws)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+  constexpr size_t prf_cnt = 2 * k + 1;
+  constexpr size_t prf_out_len = 64 * std::max(eta1, eta2);
+
+  const auto prf_in_of = [&](const size_t idx, std::span<uint8_t, 33> prf_in) {
+    const std::span<const uint8_t, 32> seed = seed_of(idx / prf_cnt);
+    std::copy(seed.begin(), seed.end(), prf_in.begin());
+    prf_in[32] = static_cast<uint8_t>(idx % prf_cnt);
+  };
+  const auto sample = [&](const size_t idx, std::span<const uint8_t, prf_out_len> prf_out) {
+    auto& pke = ws.items[idx / prf_cnt].pke;
+    const size_t i = idx % prf_cnt;
+
+    if (i < k) {
+      ml_kem_utils::sample_poly_cbd<eta1>(prf_out.template first<64 * eta1>(), std::span(pke.r).subspan(i * n).template first<n>());
+    } else {
+      ml_kem_utils::sample_poly_cbd<eta2>(prf_out.template first<64 * eta2>(), std::span(pke.e).subspan((i - k) * n).template first<n>());
+    }
+  };
+
+  ml_kem_utils::sample_cbd_many_xn<lanes, prf_out_len>(cnt * prf_cnt, prf_in_of, sample);
+}
+
+// Given 2 to `lanes` -many seed pairs, this routine generates as many ML-KEM keypairs, same as `keygen` does for each of them, while
+// computing G, all PRF invocations sampling s and e, all XOFs sampling A and H of all items together, using `lanes` -way Keccak.
+//
+// See algorithm 13 and 16 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t lanes, size_t k, size_t eta1>
+inline void
+keygen_xn(std::span<const seed_pair_t> seeds,
+          std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+          std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys,
+          batch_workspace_t<k>& ws)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+  constexpr size_t pke_sk_len = ml_kem_utils::get_pke_secret_key_len(k);
+  constexpr size_t pke_pk_len = ml_kem_utils::get_pke_public_key_len(k);
+  constexpr size_t rate_g = sha3_512::RATE / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t rate_h = sha3_256::RATE / std::numeric_limits<uint8_t>::digits;
+
+  const size_t cnt = seeds.size();
+
+  // Unused lanes hash a copy of the first item, whose digest is thrown away.
+  std::array<std::array<uint8_t, 32 + 1>, lanes> g_in{};
+  std::array<std::array<uint8_t, sha3_512::DIGEST_LEN>, lanes> g_out{};
+  std::array<std::array<uint8_t, sha3_256::DIGEST_LEN>, lanes> h_out{};
+
+  std::array<std::span<const uint8_t>, lanes> ins{};
+  std::array<std::span<uint8_t>, lanes> outs{};
+
+  // Line 1 of algorithm 13, (ρ, σ) ← G(d || k)
+  for (size_t j = 0; j < lanes; j++) {
+    const auto& d = seeds[(j < cnt) ? j : 0].d;
+    std::copy(d.begin(), d.end(), g_in[j].begin());
+    g_in[j][d.size()] = k; // Domain seperator to prevent misuse of key
+
+    ins[j] = g_in[j];
+    outs[j] = g_out[j];
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_g, 0x06> g;
+  g.absorb(ins);
+  g.finalize();
+  g.squeeze(outs);
+
+  const auto rho = [&](const size_t idx) { return std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template first<32>(); };
+  const auto sigma = [&](const size_t idx) { return std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template last<32>(); };
+
+  // Line 8-15 of algorithm 13, both s and e of each item are sampled using nonces 0, 1, ..., 2k-1, in that order.
+  const auto prf_in_of = [&](const size_t idx, std::span<uint8_t, 33> prf_in) {
+    const auto seed = sigma(idx / (2 * k));
+    std::copy(seed.begin(), seed.end(), prf_in.begin());
+    prf_in[32] = static_cast<uint8_t>(idx % (2 * k));
+  };
+  const auto sample = [&](const size_t idx, std::span<const uint8_t, 64 * eta1> prf_out) {
+    auto& pke = ws.items[idx / (2 * k)].pke;
+    const size_t i = idx % (2 * k);
+
+    auto poly = (i < k) ? std::span(pke.s).subspan(i * n).template first<n>() : std::span(pke.e).subspan((i - k) * n).template first<n>();
+    ml_kem_utils::sample_poly_cbd<eta1>(prf_out, poly);
+  };
+
+  ml_kem_utils::sample_cbd_many_xn<lanes, 64 * eta1>(cnt * 2 * k, prf_in_of, sample);
+
+  // Line 3-7 of algorithm 13, each entry of matrix A of each item is sampled from its own XOF.
+  const auto xof_in_of = [&](const size_t idx, std::span<uint8_t, 34> xof_in) {
+    const auto seed = rho(idx / (k * k));
+    std::copy(seed.begin(), seed.end(), xof_in.begin());
+    ml_kem_utils::set_matrix_xof_nonces<false>(xof_in, (idx % (k * k)) / k, idx % k);
+  };
+  const auto poly_of = [&](const size_t idx) {
+    return std::span(ws.items[idx / (k * k)].A_prime).subspan((idx % (k * k)) * n).template first<n>();
+  };
+
+  ml_kem_utils::sample_ntt_many_xn<lanes>(cnt * k * k, xof_in_of, poly_of);
+
+  using vec_t = std::span<const int16_t, k * n>;
+  using cache_t = std::span<const int16_t, k * n / 2>;
+  using out_t = std::span<int16_t, k * n>;
+
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto& item = ws.items[idx];
+    auto seckey = std::span(seckeys[idx]);
+
+    auto kpke_skey_in_seckey = seckey.template subspan<0, pke_sk_len>();
+    auto kpke_pkey_in_seckey = seckey.template subspan<pke_sk_len, pke_pk_len>();
+    auto z_in_seckey = seckey.template last<32>();
+
+    const auto mul_A = [&](vec_t s, cache_t s_cache, out_t t) { ml_kem_utils::matrix_multiply<k, k, k, 1>(item.A_prime, s, s_cache, t); };
+    k_pke::keygen_sampled<k>(rho(idx), mul_A, kpke_pkey_in_seckey, kpke_skey_in_seckey, item.t_prime, item.pke);
+
+    std::copy(kpke_pkey_in_seckey.begin(), kpke_pkey_in_seckey.end(), pubkeys[idx].begin());
+    std::copy(seeds[idx].z.begin(), seeds[idx].z.end(), z_in_seckey.begin());
+  }
+
+  // Line 3 of algorithm 16, H(ek) is placed right before z in secret key
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = pubkeys[(j < cnt) ? j : 0];
+    outs[j] = (j < cnt) ? std::span(seckeys[j]).template subspan<pke_sk_len + pke_pk_len, sha3_256::DIGEST_LEN>() : std::span(h_out[j]);
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_h, 0x06> h;
+  h.absorb(ins);
+  h.finalize();
+  h.squeeze(outs);
+
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+}
+
+// Given N seed pairs, this routine generates N ML-KEM keypairs, each being byte-identical to what `keygen` produces for respective seed
+// pair, using caller-supplied batch workspace. On CPUs supporting AVX2 ( or AVX-512 ), up to 4 ( or 8 ) keypairs are generated together,
+// with their hashing and sampling interleaved across lanes of multi-lane Keccak, while a leftover single keypair is generated by
+// `keygen`. If the spans are not of same length, it returns false, without generating any keypair.
+//
+// See algorithm 16 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1>
+[[nodiscard("Use result, it fails if spans are not of same length")]] constexpr bool
+keygen_batch(std::span<const seed_pair_t> seeds,
+             std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+             std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys,
+             batch_workspace_t<k>& ws)
+  requires(ml_kem_params::check_keygen_params(k, eta1))
+{
+  if ((pubkeys.size() != seeds.size()) || (seckeys.size() != seeds.size())) {
+    return false;
+  }
+
+  size_t off = 0;
+  if (!std::is_constant_evaluated()) {
+    off = for_each_chunk_xn(seeds.size(), [&](auto lanes, const size_t beg, const size_t len) {
+      keygen_xn<decltype(lanes)::value, k, eta1>(seeds.subspan(beg, len), pubkeys.subspan(beg, len), seckeys.subspan(beg, len), ws);
+    });
+  }
+
+  for (; off < seeds.size(); off++) {
+    keygen<k, eta1, false>(seeds[off].d, seeds[off].z, pubkeys[off], seckeys[off], ws.items[0]);
+  }
+
+  return true;
+}
+
+// Given N seed pairs, this routine generates N ML-KEM keypairs, same as `keygen_batch` above does, using a batch workspace, allocated on
+// heap. If the spans are not of same length, it returns false, without generating any keypair.
+template<size_t k, size_t eta1>
+[[nodiscard("Use result, it fails if spans are not of same length")]] inline bool
+keygen_batch(std::span<const seed_pair_t> seeds,
+             std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+             std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys)
+  requires(ml_kem_params::check_keygen_params(k, eta1))
+{
+  auto ws = std::make_unique<batch_workspace_t<k>>();
+  return keygen_batch<k, eta1>(seeds, pubkeys, seckeys, *ws);
+}
+
+// Given 2 to `lanes` -many seeds `m` and as many public keys, this routine computes a cipher text and a shared secret for each of them,
+// same as `encapsulate` does, while computing H, G, all PRF invocations sampling r, e1 and e2, and all XOFs sampling A of all items
+// together, using `lanes` -way Keccak. Returns result of modulus check of each public key. Outputs of an item, whose public key fails
+// the modulus check, are left untouched.
+//
+// See algorithm 14 and 17 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t lanes, size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+inline std::array<bool, lanes>
+encapsulate_xn(std::span<const std::array<uint8_t, 32>> ms,
+               std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+               std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+               std::span<std::array<uint8_t, 32>> shared_secrets,
+               batch_workspace_t<k>& ws)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+  constexpr size_t rate_g = sha3_512::RATE / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t rate_h = sha3_256::RATE / std::numeric_limits<uint8_t>::digits;
+
+  const size_t cnt = ms.size();
+
+  // Unused lanes hash a copy of the first item, whose digest is thrown away.
+  std::array<std::array<uint8_t, 32 + sha3_256::DIGEST_LEN>, lanes> g_in{};
+  std::array<std::array<uint8_t, sha3_512::DIGEST_LEN>, lanes> g_out{};
+
+  std::array<std::span<const uint8_t>, lanes> ins{};
+  std::array<std::span<uint8_t>, lanes> outs{};
+
+  // Line 1 of algorithm 17, (K, r) ← G(m || H(ek)), where H(ek) is squeezed right into input of G
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = pubkeys[(j < cnt) ? j : 0];
+    outs[j] = std::span(g_in[j]).template last<sha3_256::DIGEST_LEN>();
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_h, 0x06> h;
+  h.absorb(ins);
+  h.finalize();
+  h.squeeze(outs);
+
+  for (size_t j = 0; j < lanes; j++) {
+    const auto& m = ms[(j < cnt) ? j : 0];
+    std::copy(m.begin(), m.end(), g_in[j].begin());
+
+    ins[j] = g_in[j];
+    outs[j] = g_out[j];
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_g, 0x06> g;
+  g.absorb(ins);
+  g.finalize();
+  g.squeeze(outs);
+
+  // Line 2 of algorithm 14, along with modulus check of each public key
+  std::array<bool, lanes> is_valid{};
+  for (size_t idx = 0; idx < cnt; idx++) {
+    is_valid[idx] = k_pke::decode_pubkey<k>(pubkeys[idx], ws.items[idx].t_prime);
+  }
+
+  const auto rcoin = [&](const size_t idx) { return std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template last<32>(); };
+
+  // Line 9-17 of algorithm 14, r, e1 and e2 of each item
+  sample_encrypt_noise_xn<lanes, k, eta1, eta2>(rcoin, cnt, ws);
+
+  // Line 3-8 of algorithm 14, each entry of transpose of matrix A of each item is sampled from its own XOF.
+  const auto xof_in_of = [&](const size_t idx, std::span<uint8_t, 34> xof_in) {
+    const auto rho = std::span(pubkeys[idx / (k * k)]).template last<32>();
+    std::copy(rho.begin(), rho.end(), xof_in.begin());
+    ml_kem_utils::set_matrix_xof_nonces<true>(xof_in, (idx % (k * k)) / k, idx % k);
+  };
+  const auto poly_of = [&](const size_t idx) {
+    return std::span(ws.items[idx / (k * k)].A_prime).subspan((idx % (k * k)) * n).template first<n>();
+  };
+
+  ml_kem_utils::sample_ntt_many_xn<lanes>(cnt * k * k, xof_in_of, poly_of);
+
+  using vec_t = std::span<const int16_t, k * n>;
+  using cache_t = std::span<const int16_t, k * n / 2>;
+  using out_t = std::span<int16_t, k * n>;
+
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto& item = ws.items[idx];
+
+    if (!is_valid[idx]) {
+      // Got an invalid public key, whose sampled noise is to be discarded
+      ml_kem_utils::secure_zeroize(item.pke.r);
+      ml_kem_utils::secure_zeroize(item.pke.e);
+      continue;
+    }
+
+    const auto mul_A = [&](vec_t r, cache_t r_cache, out_t u) { ml_kem_utils::matrix_multiply<k, k, k, 1>(item.A_prime, r, r_cache, u); };
+    k_pke::encrypt_sampled<k, du, dv>(item.t_prime, mul_A, ms[idx], ciphers[idx], item.pke);
+
+    const auto shared_secret = std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template first<32>();
+    std::copy(shared_secret.begin(), shared_secret.end(), shared_secrets[idx].begin());
+  }
+
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+
+  return is_valid;
+}
+
+// Given N seeds `m` and N ML-KEM public keys, this routine computes N cipher texts and shared secrets, each being byte-identical to what
+// `encapsulate` produces for respective seed and public key, using caller-supplied batch workspace. On CPUs supporting AVX2 ( or
+// AVX-512 ), up to 4 ( or 8 ) items are encapsulated together, with their hashing and sampling interleaved across lanes of multi-lane
+// Keccak. Returns a bitmap, whose bit i is set iff public key i passed the modulus check, as described in point (2) of section 7.2 of
+// ML-KEM specification, while outputs of items with malformed public key are left untouched. If the spans are not of same length,
+// nothing is encapsulated and an empty bitmap is returned.
+//
+// See algorithm 17 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it tells which of the public keys are malformed")]] constexpr std::vector<bool>
+encapsulate_batch(std::span<const std::array<uint8_t, 32>> ms,
+                  std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+                  std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                  std::span<std::array<uint8_t, 32>> shared_secrets,
+                  batch_workspace_t<k>& ws)
+  requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+{
+  const size_t cnt = ms.size();
+  if ((pubkeys.size() != cnt) || (ciphers.size() != cnt) || (shared_secrets.size() != cnt)) {
+    return {};
+  }
+
+  std::vector<bool> is_valid(cnt, false);
+
+  size_t off = 0;
+  if (!std::is_constant_evaluated()) {
+    off = for_each_chunk_xn(cnt, [&](auto lanes, const size_t beg, const size_t len) {
+      const auto chunk_is_valid = encapsulate_xn<decltype(lanes)::value, k, eta1, eta2, du, dv>(
+        ms.subspan(beg, len), pubkeys.subspan(beg, len), ciphers.subspan(beg, len), shared_secrets.subspan(beg, len), ws);
+
+      for (size_t j = 0; j < len; j++) {
+        is_valid[beg + j] = chunk_is_valid[j];
+      }
+    });
+  }
+
+  for (; off < cnt; off++) {
+    is_valid[off] = encapsulate<k, eta1, eta2, du, dv, false>(ms[off], pubkeys[off], ciphers[off], shared_secrets[off], ws.items[0]);
+  }
+
+  return is_valid;
+}
+
+// Given N seeds `m` and N ML-KEM public keys, this routine computes N cipher texts and shared secrets, same as `encapsulate_batch` above
+// does, using a batch workspace, allocated on heap. Returns bitmap of modulus check results, which is empty if the spans are not of same
+// length.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it tells which of the public keys are malformed")]] inline std::vector<bool>
+encapsulate_batch(std::span<const std::array<uint8_t, 32>> ms,
+                  std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+                  std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                  std::span<std::array<uint8_t, 32>> shared_secrets)
+  requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+{
+  auto ws = std::make_unique<batch_workspace_t<k>>();
+  return encapsulate_batch<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets, *ws);
+}
+
+// Given 2 to `lanes` -many cipher texts, this routine decapsulates each of them, using same prepared secret key, same as `decapsulate`
+// does, while computing G, J and all PRF invocations sampling r, e1 and e2 of all items together, using `lanes` -way Keccak. Decrypted
+// messages and re-encryptions are computed one item at a time, using decoded s, t and expanded matrix A of the prepared secret key.
+// Implicit rejection stays constant-time per item.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t lanes, size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+inline void
+decapsulate_xn(const prepared_seckey_t<k>& seckey,
+               std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+               std::span<std::array<uint8_t, 32>> shared_secrets,
+               batch_workspace_t<k>& ws)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+  constexpr size_t ctlen = ml_kem_utils::get_kem_cipher_text_len(k, du, dv);
+  constexpr size_t rate_g = sha3_512::RATE / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t rate_j = shake256::RATE / std::numeric_limits<uint8_t>::digits;
+
+  const size_t cnt = ciphers.size();
+
+  // Unused lanes hash a copy of the first item, whose digest is thrown away.
+  std::array<std::array<uint8_t, 32 + sha3_256::DIGEST_LEN>, lanes> g_in{};
+  std::array<std::array<uint8_t, sha3_512::DIGEST_LEN>, lanes> g_out{};
+  std::array<std::array<uint8_t, 32>, lanes> j_out{};
+
+  std::array<std::span<const uint8_t>, lanes> ins{};
+  std::array<std::span<uint8_t>, lanes> outs{};
+
+  // Line 7 of algorithm 18, m' ← K-PKE.Decrypt(dk_pke, c), for each item
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto m_prime = std::span(g_in[idx]).template first<32>();
+    k_pke::decrypt_prepared<k, du, dv>(seckey.s_prime, seckey.s_cache, ciphers[idx], m_prime, ws.items[idx].pke);
+  }
+
+  // Line 7-8 of algorithm 18, (K', r') ← G(m' || h) and K̄ ← J(z || c)
+  for (size_t j = 0; j < lanes; j++) {
+    std::copy(seckey.pubkey.h.begin(), seckey.pubkey.h.end(), std::span(g_in[j]).template last<sha3_256::DIGEST_LEN>().begin());
+
+    ins[j] = g_in[(j < cnt) ? j : 0];
+    outs[j] = g_out[j];
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_g, 0x06> g;
+  g.absorb(ins);
+  g.finalize();
+  g.squeeze(outs);
+
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = seckey.z;
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_j> xof_j;
+  xof_j.absorb(ins);
+
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = ciphers[(j < cnt) ? j : 0];
+    outs[j] = j_out[j];
+  }
+
+  xof_j.absorb(ins);
+  xof_j.finalize();
+  xof_j.squeeze(outs);
+
+  const auto rcoin = [&](const size_t idx) { return std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template last<32>(); };
+
+  // Line 9-17 of algorithm 14, r, e1 and e2 of each re-encryption
+  sample_encrypt_noise_xn<lanes, k, eta1, eta2>(rcoin, cnt, ws);
+
+  using vec_t = std::span<const int16_t, k * n>;
+  using cache_t = std::span<const int16_t, k * n / 2>;
+  using out_t = std::span<int16_t, k * n>;
+  using kdf_t = std::span<const uint8_t, 32>;
+
+  const auto mul_A = [&](vec_t r, cache_t r_cache, out_t u) { ml_kem_utils::matrix_multiply<k, k, k, 1>(seckey.pubkey.A_prime, r, r_cache, u); };
+
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto& item = ws.items[idx];
+    auto c_prime = std::span(item.c_prime).template first<ctlen>();
+
+    // Line 9 of algorithm 18, c' ← K-PKE.Encrypt(ek_pke, m', r')
+    k_pke::encrypt_sampled<k, du, dv>(seckey.pubkey.t_prime, mul_A, std::span(g_in[idx]).template first<32>(), c_prime, item.pke);
+
+    // Line 10-11 of algorithm 18, in constant-time
+    const uint32_t cond = ml_kem_utils::ct_memcmp(std::span<const uint8_t, ctlen>(ciphers[idx]), std::span<const uint8_t, ctlen>(c_prime));
+    ml_kem_utils::ct_cond_memcpy(cond, std::span(shared_secrets[idx]), kdf_t(std::span(g_out[idx]).template first<32>()), kdf_t(j_out[idx]));
+
+    ml_kem_utils::secure_zeroize(c_prime);
+  }
+
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+  ml_kem_utils::secure_zeroize(j_out);
+}
+
+// Given a prepared ML-KEM secret key and N cipher texts, this routine computes N shared secrets, each being byte-identical to what
+// `decapsulate` produces for respective cipher text, using caller-supplied batch workspace. On CPUs supporting AVX2 ( or AVX-512 ), up
+// to 4 ( or 8 ) cipher texts are decapsulated together, with their hashing and sampling interleaved across lanes of multi-lane Keccak.
+// If the spans are not of same length, it returns false, without decapsulating any cipher text.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it fails if spans are not of same length")]] constexpr bool
+decapsulate_batch(const prepared_seckey_t<k>& seckey,
+                  std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                  std::span<std::array<uint8_t, 32>> shared_secrets,
+                  batch_workspace_t<k>& ws)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  constexpr size_t ctlen = ml_kem_utils::get_kem_cipher_text_len(k, du, dv);
+
+  const size_t cnt = ciphers.size();
+  if (shared_secrets.size() != cnt) {
+    return false;
+  }
+
+  size_t off = 0;
+  if (!std::is_constant_evaluated()) {
+    off = for_each_chunk_xn(cnt, [&](auto lanes, const size_t beg, const size_t len) {
+      decapsulate_xn<decltype(lanes)::value, k, eta1, eta2, du, dv>(seckey, ciphers.subspan(beg, len), shared_secrets.subspan(beg, len), ws);
+    });
+  }
+
+  for (; off < cnt; off++) {
+    auto c_prime = std::span(ws.items[0].c_prime).template first<ctlen>();
+    decapsulate_with<k, eta1, eta2, du, dv>(seckey, ciphers[off], shared_secrets[off], ws.items[0].pke, c_prime);
+  }
+
+  return true;
+}
+
+// Given ML-KEM secret key and N cipher texts, this routine computes N shared secrets, each being byte-identical to what `decapsulate`
+// produces for respective cipher text, using caller-supplied batch workspace. Vector s is decoded, and matrix A is expanded, only once,
+// into the batch workspace, which is then used for decapsulating all cipher texts, as `decapsulate_batch` above does. Same as
+// `decapsulate`, the secret key is *assumed* to be valid, though if its public key fails the modulus check, each cipher text is
+// decapsulated by `decapsulate`, keeping the output byte-identical. Decoded secret material is zeroized before returning. If the spans
+// are not of same length, it returns false, without decapsulating any cipher text.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it fails if spans are not of same length")]] constexpr bool
+decapsulate_batch(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey,
+                  std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                  std::span<std::array<uint8_t, 32>> shared_secrets,
+                  batch_workspace_t<k>& ws)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  constexpr size_t pke_sk_len = ml_kem_utils::get_pke_secret_key_len(k);
+  constexpr size_t pke_pk_len = ml_kem_utils::get_pke_public_key_len(k);
+
+  if (shared_secrets.size() != ciphers.size()) {
+    return false;
+  }
+
+  auto pke_sk = seckey.template subspan<0, pke_sk_len>();
+  auto pubkey = seckey.template subspan<pke_sk_len, pke_pk_len>();
+  auto h = seckey.template subspan<pke_sk_len + pke_pk_len, sha3_256::DIGEST_LEN>();
+  auto z = seckey.template last<32>();
+
+  auto& prepared = ws.seckey;
+
+  // Public key, held as part of secret key, is *assumed* to be valid. If it's not, re-encryption of `decapsulate` gives up on it and
+  // implicitly rejects all non-zero cipher texts, which a prepared secret key can't reproduce, so each cipher text is decapsulated as is.
+  if (!k_pke::decode_pubkey<k>(pubkey, prepared.pubkey.t_prime)) {
+    for (size_t off = 0; off < ciphers.size(); off++) {
+      decapsulate<k, eta1, eta2, du, dv, false>(seckey, ciphers[off], shared_secrets[off], ws.items[0]);
+    }
+
+    return true;
+  }
+
+  ml_kem_utils::generate_matrix<k, true>(prepared.pubkey.A_prime, pubkey.template last<32>());
+  std::copy(h.begin(), h.end(), prepared.pubkey.h.begin());
+
+  ml_kem_utils::poly_vec_decode<k, 12>(pke_sk, prepared.s_prime);
+  ml_kem_utils::poly_vec_mulcache<k>(prepared.s_prime, prepared.s_cache);
+  std::copy(z.begin(), z.end(), prepared.z.begin());
+
+  const bool is_decapsulated = decapsulate_batch<k, eta1, eta2, du, dv>(prepared, ciphers, shared_secrets, ws);
+
+  ml_kem_utils::secure_zeroize(prepared.s_prime);
+  ml_kem_utils::secure_zeroize(prepared.s_cache);
+  ml_kem_utils::secure_zeroize(prepared.z);
+
+  return is_decapsulated;
+}
+
+// Given ML-KEM secret key ( either byte serialized or prepared ) and N cipher texts, this routine computes N shared secrets, same as
+// `decapsulate_batch` above does, using a batch workspace, allocated on heap. If the spans are not of same length, it returns false.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, typename seckey_t>
+[[nodiscard("Use result, it fails if spans are not of same length")]] inline bool
+decapsulate_batch(const seckey_t& seckey,
+                  std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                  std::span<std::array<uint8_t, 32>> shared_secrets)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  auto ws = std::make_unique<batch_workspace_t<k>>();
+  return decapsulate_batch<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets, *ws);
+}
+
+// Given 2 to `lanes` -many prepared secret keys and a cipher text, already decoded into the batch workspace, this routine decapsulates
+// the cipher text under each of the secret keys, same as `decapsulate` does, while computing G, J and all PRF invocations sampling r, e1
+// and e2 of all keys together, using `lanes` -way Keccak. Decryption and re-encryption are computed one key at a time, using decoded s,
+// t and expanded matrix A of respective prepared secret key. Implicit rejection stays constant-time per key.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t lanes, size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+inline void
+decapsulate_many_keys_xn(std::span<const prepared_seckey_t<k>> seckeys,
+                         std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+                         std::span<std::array<uint8_t, 32>> shared_secrets,
+                         batch_workspace_t<k>& ws)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+  constexpr size_t ctlen = ml_kem_utils::get_kem_cipher_text_len(k, du, dv);
+  constexpr size_t rate_g = sha3_512::RATE / std::numeric_limits<uint8_t>::digits;
+  constexpr size_t rate_j = shake256::RATE / std::numeric_limits<uint8_t>::digits;
+
+  const size_t cnt = seckeys.size();
+
+  // Unused lanes hash a copy of the first item, whose digest is thrown away.
+  std::array<std::array<uint8_t, 32 + sha3_256::DIGEST_LEN>, lanes> g_in{};
+  std::array<std::array<uint8_t, sha3_512::DIGEST_LEN>, lanes> g_out{};
+  std::array<std::array<uint8_t, 32>, lanes> j_out{};
+
+  std::array<std::span<const uint8_t>, lanes> ins{};
+  std::array<std::span<uint8_t>, lanes> outs{};
+
+  // Line 7 of algorithm 18, m' ← K-PKE.Decrypt(dk_pke, c), for each key, where decoded v is consumed by decryption
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto& pke = ws.items[idx].pke;
+    const auto& seckey = seckeys[idx];
+
+    std::copy(ws.v.begin(), ws.v.end(), pke.v.begin());
+    k_pke::decrypt_decoded<k>(seckey.s_prime, seckey.s_cache, ws.u_prime, std::span(g_in[idx]).template first<32>(), pke);
+  }
+
+  // Line 7-8 of algorithm 18, (K', r') ← G(m' || h) and K̄ ← J(z || c)
+  for (size_t j = 0; j < lanes; j++) {
+    const auto& h = seckeys[(j < cnt) ? j : 0].pubkey.h;
+    std::copy(h.begin(), h.end(), std::span(g_in[j]).template last<sha3_256::DIGEST_LEN>().begin());
+
+    ins[j] = g_in[(j < cnt) ? j : 0];
+    outs[j] = g_out[j];
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_g, 0x06> g;
+  g.absorb(ins);
+  g.finalize();
+  g.squeeze(outs);
+
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = seckeys[(j < cnt) ? j : 0].z;
+  }
+
+  ml_kem_keccak::shake_xn_t<lanes, rate_j> xof_j;
+  xof_j.absorb(ins);
+
+  for (size_t j = 0; j < lanes; j++) {
+    ins[j] = cipher;
+    outs[j] = j_out[j];
+  }
+
+  xof_j.absorb(ins);
+  xof_j.finalize();
+  xof_j.squeeze(outs);
+
+  const auto rcoin = [&](const size_t idx) { return std::span<const uint8_t, sha3_512::DIGEST_LEN>(g_out[idx]).template last<32>(); };
+
+  // Line 9-17 of algorithm 14, r, e1 and e2 of each re-encryption
+  sample_encrypt_noise_xn<lanes, k, eta1, eta2>(rcoin, cnt, ws);
+
+  using vec_t = std::span<const int16_t, k * n>;
+  using cache_t = std::span<const int16_t, k * n / 2>;
+  using out_t = std::span<int16_t, k * n>;
+  using kdf_t = std::span<const uint8_t, 32>;
+
+  for (size_t idx = 0; idx < cnt; idx++) {
+    auto& item = ws.items[idx];
+    const auto& pubkey = seckeys[idx].pubkey;
+    auto c_prime = std::span(item.c_prime).template first<ctlen>();
+
+    // Line 9 of algorithm 18, c' ← K-PKE.Encrypt(ek_pke, m', r')
+    const auto mul_A = [&](vec_t r, cache_t r_cache, out_t u) { ml_kem_utils::matrix_multiply<k, k, k, 1>(pubkey.A_prime, r, r_cache, u); };
+    k_pke::encrypt_sampled<k, du, dv>(pubkey.t_prime, mul_A, std::span(g_in[idx]).template first<32>(), c_prime, item.pke);
+
+    // Line 10-11 of algorithm 18, in constant-time
+    const uint32_t cond = ml_kem_utils::ct_memcmp(cipher, std::span<const uint8_t, ctlen>(c_prime));
+    ml_kem_utils::ct_cond_memcpy(cond, std::span(shared_secrets[idx]), kdf_t(std::span(g_out[idx]).template first<32>()), kdf_t(j_out[idx]));
+
+    ml_kem_utils::secure_zeroize(c_prime);
+  }
+
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+  ml_kem_utils::secure_zeroize(j_out);
+}
+
+// Given N prepared ML-KEM secret keys and a cipher text, this routine computes N candidate shared secrets, i-th one being byte-identical
+// to what `decapsulate` produces for the cipher text under i-th secret key, using caller-supplied batch workspace. It's meant for trial
+// decapsulation, where it's not known which of the keys, if any, the cipher text was encapsulated to. The cipher text is decoded, and
+// vector u is transformed to NTT domain, only once. On CPUs supporting AVX2 ( or AVX-512 ), up to 4 ( or 8 ) keys are processed together,
+// with their hashing and sampling interleaved across lanes of multi-lane Keccak. As a key, under which the cipher text is rejected,
+// yields a pseudorandom shared secret, nothing is branched upon, telling which key is the right one. If the spans are not of same
+// length, it returns false, without decapsulating the cipher text.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it fails if spans are not of same length")]] constexpr bool
+decapsulate_many_keys(std::span<const prepared_seckey_t<k>> seckeys,
+                      std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+                      std::span<std::array<uint8_t, 32>> shared_secrets,
+                      batch_workspace_t<k>& ws)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  constexpr size_t ctlen = ml_kem_utils::get_kem_cipher_text_len(k, du, dv);
+
+  const size_t cnt = seckeys.size();
+  if (shared_secrets.size() != cnt) {
+    return false;
+  }
+
+  k_pke::decode_cipher_text<k, du, dv>(cipher, ws.u_prime, ws.v);
+
+  size_t off = 0;
+  if (!std::is_constant_evaluated()) {
+    off = for_each_chunk_xn(cnt, [&](auto lanes, const size_t beg, const size_t len) {
+      decapsulate_many_keys_xn<decltype(lanes)::value, k, eta1, eta2, du, dv>(seckeys.subspan(beg, len), cipher, shared_secrets.subspan(beg, len), ws);
+    });
+  }
+
+  for (; off < cnt; off++) {
+    auto& item = ws.items[0];
+    auto c_prime = std::span(item.c_prime).template first<ctlen>();
+
+    std::copy(ws.v.begin(), ws.v.end(), item.pke.v.begin());
+    decapsulate_decoded<k, eta1, eta2, du, dv>(seckeys[off], cipher, ws.u_prime, shared_secrets[off], item.pke, c_prime);
+  }
+
+  return true;
+}
+
+// Given N prepared ML-KEM secret keys and a cipher text, this routine computes N candidate shared secrets, same as `decapsulate_many_keys`
+// above does, using a batch workspace, allocated on heap. If the spans are not of same length, it returns false.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+[[nodiscard("Use result, it fails if spans are not of same length")]] inline bool
+decapsulate_many_keys(std::span<const prepared_seckey_t<k>> seckeys,
+                      std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+                      std::span<std::array<uint8_t, 32>> shared_secrets)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  auto ws = std::make_unique<batch_workspace_t<k>>();
+  return decapsulate_many_keys<k, eta1, eta2, du, dv>(seckeys, cipher, shared_secrets, *ws);
+}
+
+}
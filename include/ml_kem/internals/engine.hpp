@@ -0,0 +1,442 @@
+#pragma once
+#include "ml_kem/internals/batch.hpp"
+#include "ml_kem/internals/ml_kem.hpp"
+#include "ml_kem/internals/utility/params.hpp"
+#include "ml_kem/internals/utility/utils.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+// Thread-pool engine, spreading large batches of ML-KEM key generation, encapsulation and decapsulation jobs over a fixed set of worker
+// threads, each of which runs the batched routines ( see batch.hpp ) on chunks of the job.
+namespace ml_kem {
+
+// Pool of worker threads, computing ML-KEM key generation, encapsulation and decapsulation jobs, over batches of any size. Each job is
+// split into chunks of `BATCH_LANES` items, s.t. each chunk fills all lanes of multi-lane Keccak, which are evenly distributed among
+// the workers. A worker, which is done with its own chunks, steals chunks from other workers, keeping all of them busy till the job is
+// done. Each worker owns its batch workspaces, which are allocated on first use, while Keccak states live on its own stack, so workers
+// never share any mutable state, except for queues of chunks.
+//
+// Completion of a job is signalled either through a `std::future`, or a callback, which is invoked on the worker that finishes the last
+// chunk of the job. Spans passed to a job must stay alive and must not be modified, till the job is complete. Don't wait on a future,
+// from inside a callback, as it blocks a worker. An exception thrown by a chunk never escapes the worker, it's handed to the job instead,
+// which fails once all of its chunks are done.
+class engine
+{
+public:
+  // Starts `worker_cnt` -many worker threads, at least one. By default, it's the number of concurrent threads supported by the hardware.
+  explicit engine(size_t worker_cnt = std::max<size_t>(std::thread::hardware_concurrency(), 1))
+    : workers(std::max<size_t>(worker_cnt, 1))
+  {
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i] = std::make_unique<worker_t>();
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+      workers[i]->thread = std::thread([this, i]() { work(i); });
+    }
+  }
+
+  engine(const engine&) = delete;
+  engine& operator=(const engine&) = delete;
+
+  // Waits for all submitted jobs to complete, before stopping the workers.
+  ~engine()
+  {
+    {
+      std::lock_guard<std::mutex> lock(idle_mutex);
+      stopping = true;
+    }
+    idle_cv.notify_all();
+
+    for (auto& worker : workers) {
+      worker->thread.join();
+    }
+  }
+
+  // Returns number of worker threads.
+  size_t worker_count() const { return workers.size(); }
+
+  // Given N seed pairs, this routine computes N ML-KEM keypairs, same as `keygen_batch` does, invoking `done` with true, once all of
+  // them are computed. If the spans are not of same length, `done` is invoked with false, right away, without computing any keypair. If
+  // computing any chunk of the job throws, `done` is invoked with false, once the job is over.
+  template<size_t k, size_t eta1>
+  void keygen(std::span<const seed_pair_t> seeds,
+              std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+              std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys,
+              std::function<void(bool)> done)
+    requires(ml_kem_params::check_keygen_params(k, eta1))
+  {
+    keygen_job<k, eta1>(seeds, pubkeys, seckeys, [done = std::move(done)](const bool result, std::exception_ptr failure) { done(result && !failure); });
+  }
+
+  // Same as above, but completion is signalled through the returned future. If computing any chunk of the job throws, the future holds
+  // the first exception thrown.
+  template<size_t k, size_t eta1>
+  [[nodiscard("Wait on the future, for the job to complete")]] std::future<bool>
+  keygen(std::span<const seed_pair_t> seeds,
+         std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+         std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys)
+    requires(ml_kem_params::check_keygen_params(k, eta1))
+  {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+
+    keygen_job<k, eta1>(seeds, pubkeys, seckeys, [promise](const bool result, std::exception_ptr failure) { settle(*promise, result, failure); });
+    return future;
+  }
+
+  // Given N seeds `m` and N ML-KEM public keys, this routine computes N cipher texts and shared secrets, same as `encapsulate_batch`
+  // does, invoking `done` with a bitmap, whose bit i is set iff public key i is well-formed, once all of them are computed. If the spans
+  // are not of same length, `done` is invoked with an empty bitmap, right away, without computing anything. If computing any chunk of
+  // the job throws, `done` is invoked with an empty bitmap, once the job is over.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+  void encapsulate(std::span<const std::array<uint8_t, 32>> ms,
+                   std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+                   std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                   std::span<std::array<uint8_t, 32>> shared_secrets,
+                   std::function<void(std::vector<bool>)> done)
+    requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+  {
+    encapsulate_job<k, eta1, eta2, du, dv>(
+      ms, pubkeys, ciphers, shared_secrets, [done = std::move(done)](std::vector<bool> result, std::exception_ptr failure) {
+        done(failure ? std::vector<bool>{} : std::move(result));
+      });
+  }
+
+  // Same as above, but completion is signalled through the returned future. If computing any chunk of the job throws, the future holds
+  // the first exception thrown.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+  [[nodiscard("Wait on the future, for the job to complete")]] std::future<std::vector<bool>>
+  encapsulate(std::span<const std::array<uint8_t, 32>> ms,
+              std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+              std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+              std::span<std::array<uint8_t, 32>> shared_secrets)
+    requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+  {
+    auto promise = std::make_shared<std::promise<std::vector<bool>>>();
+    auto future = promise->get_future();
+
+    encapsulate_job<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets, [promise](std::vector<bool> result, std::exception_ptr failure) {
+      settle(*promise, std::move(result), failure);
+    });
+    return future;
+  }
+
+  // Given a prepared ML-KEM secret key and N cipher texts, this routine computes N shared secrets, same as `decapsulate_batch` does,
+  // invoking `done` with true, once all of them are computed. The secret key is prepared once, by the caller, s.t. workers don't have to
+  // decode it for each chunk. If the spans are not of same length, `done` is invoked with false, right away, without computing anything.
+  // If computing any chunk of the job throws, `done` is invoked with false, once the job is over.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+  void decapsulate(const prepared_seckey_t<k>& seckey,
+                   std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                   std::span<std::array<uint8_t, 32>> shared_secrets,
+                   std::function<void(bool)> done)
+    requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+  {
+    decapsulate_job<k, eta1, eta2, du, dv>(
+      seckey, ciphers, shared_secrets, [done = std::move(done)](const bool result, std::exception_ptr failure) { done(result && !failure); });
+  }
+
+  // Same as above, but completion is signalled through the returned future. If computing any chunk of the job throws, the future holds
+  // the first exception thrown.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+  [[nodiscard("Wait on the future, for the job to complete")]] std::future<bool>
+  decapsulate(const prepared_seckey_t<k>& seckey,
+              std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+              std::span<std::array<uint8_t, 32>> shared_secrets)
+    requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+  {
+    auto promise = std::make_shared<std::promise<bool>>();
+    auto future = promise->get_future();
+
+    decapsulate_job<k, eta1, eta2, du, dv>(
+      seckey, ciphers, shared_secrets, [promise](const bool result, std::exception_ptr failure) { settle(*promise, result, failure); });
+    return future;
+  }
+
+private:
+  struct worker_t;
+
+  // Submits a key generation job, invoking `finish(result, failure)`, once it's over, where `failure` holds the first exception thrown by
+  // any chunk of the job, if any. If the spans are not of same length, `finish` is invoked with false, right away.
+  template<size_t k, size_t eta1, typename finish_fn_t>
+  void keygen_job(std::span<const seed_pair_t> seeds,
+                  std::span<std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+                  std::span<std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)>> seckeys,
+                  finish_fn_t&& finish)
+  {
+    const size_t cnt = seeds.size();
+    if ((pubkeys.size() != cnt) || (seckeys.size() != cnt)) {
+      finish(false, std::exception_ptr{});
+      return;
+    }
+
+    submit(
+      cnt,
+      [=](worker_t& worker, const size_t beg, const size_t len) {
+        (void)keygen_batch<k, eta1>(seeds.subspan(beg, len), pubkeys.subspan(beg, len), seckeys.subspan(beg, len), worker.workspace<k>());
+      },
+      [finish = std::forward<finish_fn_t>(finish)](std::exception_ptr failure) { finish(true, failure); });
+  }
+
+  // Submits an encapsulation job, invoking `finish(bitmap, failure)`, once it's over, same as `keygen_job` does. If the spans are not of
+  // same length, `finish` is invoked with an empty bitmap, right away.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, typename finish_fn_t>
+  void encapsulate_job(std::span<const std::array<uint8_t, 32>> ms,
+                       std::span<const std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)>> pubkeys,
+                       std::span<std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                       std::span<std::array<uint8_t, 32>> shared_secrets,
+                       finish_fn_t&& finish)
+  {
+    const size_t cnt = ms.size();
+    if ((pubkeys.size() != cnt) || (ciphers.size() != cnt) || (shared_secrets.size() != cnt)) {
+      finish(std::vector<bool>{}, std::exception_ptr{});
+      return;
+    }
+
+    // Each chunk writes its own bytes, as bits of a std::vector<bool> can't be written concurrently.
+    auto is_valid = std::make_shared<std::vector<uint8_t>>(cnt);
+
+    submit(
+      cnt,
+      [=](worker_t& worker, const size_t beg, const size_t len) {
+        const auto valid = encapsulate_batch<k, eta1, eta2, du, dv>(
+          ms.subspan(beg, len), pubkeys.subspan(beg, len), ciphers.subspan(beg, len), shared_secrets.subspan(beg, len), worker.workspace<k>());
+        std::copy(valid.begin(), valid.end(), is_valid->begin() + static_cast<std::ptrdiff_t>(beg));
+      },
+      [is_valid, finish = std::forward<finish_fn_t>(finish)](std::exception_ptr failure) {
+        finish(std::vector<bool>(is_valid->begin(), is_valid->end()), failure);
+      });
+  }
+
+  // Submits a decapsulation job, invoking `finish(result, failure)`, once it's over, same as `keygen_job` does. If the spans are not of
+  // same length, `finish` is invoked with false, right away.
+  template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, typename finish_fn_t>
+  void decapsulate_job(const prepared_seckey_t<k>& seckey,
+                       std::span<const std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)>> ciphers,
+                       std::span<std::array<uint8_t, 32>> shared_secrets,
+                       finish_fn_t&& finish)
+  {
+    const size_t cnt = ciphers.size();
+    if (shared_secrets.size() != cnt) {
+      finish(false, std::exception_ptr{});
+      return;
+    }
+
+    const auto* prepared = &seckey;
+
+    submit(
+      cnt,
+      [=](worker_t& worker, const size_t beg, const size_t len) {
+        (void)decapsulate_batch<k, eta1, eta2, du, dv>(*prepared, ciphers.subspan(beg, len), shared_secrets.subspan(beg, len), worker.workspace<k>());
+      },
+      [finish = std::forward<finish_fn_t>(finish)](std::exception_ptr failure) { finish(true, failure); });
+  }
+
+  // Fulfills the promise of a job, either with its result, or with the first exception thrown by any of its chunks.
+  template<typename result_t>
+  static void settle(std::promise<result_t>& promise, result_t result, std::exception_ptr failure)
+  {
+    if (failure) {
+      promise.set_exception(failure);
+    } else {
+      promise.set_value(std::move(result));
+    }
+  }
+
+  // A job, split into chunks of `BATCH_LANES` items. Whoever finishes the last chunk, completes the job, passing on the first exception
+  // thrown by any of its chunks, if any.
+  struct job_t
+  {
+    virtual ~job_t() = default;
+    virtual void run(worker_t& worker, size_t beg, size_t len) = 0;
+    virtual void complete(std::exception_ptr ex) = 0;
+
+    void fail(std::exception_ptr ex)
+    {
+      std::lock_guard<std::mutex> lock(failure_mutex);
+      if (!failure) {
+        failure = std::move(ex);
+      }
+    }
+
+    size_t item_cnt = 0;
+    std::atomic<size_t> pending_chunks{ 0 };
+
+    std::mutex failure_mutex{};
+    std::exception_ptr failure{};
+  };
+
+  // State owned by a worker thread. Its queue of chunks is shared with other workers, which steal from its back, while the worker pops
+  // from its front.
+  struct worker_t
+  {
+    std::thread thread{};
+
+    std::mutex queue_mutex{};
+    std::deque<std::pair<std::shared_ptr<job_t>, size_t>> queue{};
+
+    // Batch workspace for each k ∈ {2, 3, 4}, allocated on first use.
+    std::tuple<std::unique_ptr<batch_workspace_t<2>>, std::unique_ptr<batch_workspace_t<3>>, std::unique_ptr<batch_workspace_t<4>>> workspaces{};
+
+    template<size_t k>
+    batch_workspace_t<k>& workspace()
+    {
+      auto& ws = std::get<k - 2>(workspaces);
+      if (!ws) {
+        ws = std::make_unique<batch_workspace_t<k>>();
+      }
+      return *ws;
+    }
+  };
+
+  template<typename run_fn_t, typename complete_fn_t>
+  struct job_of_t final : job_t
+  {
+    run_fn_t run_fn;
+    complete_fn_t complete_fn;
+
+    job_of_t(run_fn_t run, complete_fn_t complete)
+      : run_fn(std::move(run))
+      , complete_fn(std::move(complete))
+    {
+    }
+
+    void run(worker_t& worker, const size_t beg, const size_t len) override { run_fn(worker, beg, len); }
+    void complete(std::exception_ptr ex) override { complete_fn(std::move(ex)); }
+  };
+
+  // Splits a job over `cnt` items into chunks, handing each worker a contiguous range of them. An empty job is completed right away.
+  template<typename run_fn_t, typename complete_fn_t>
+  void submit(const size_t cnt, run_fn_t&& run, complete_fn_t&& complete)
+  {
+    if (cnt == 0) {
+      complete(std::exception_ptr{});
+      return;
+    }
+
+    auto job = std::make_shared<job_of_t<std::decay_t<run_fn_t>, std::decay_t<complete_fn_t>>>(std::forward<run_fn_t>(run),
+                                                                                                 std::forward<complete_fn_t>(complete));
+
+    const size_t chunk_cnt = (cnt + BATCH_LANES - 1) / BATCH_LANES;
+    const size_t worker_cnt = workers.size();
+
+    job->item_cnt = cnt;
+    job->pending_chunks.store(chunk_cnt, std::memory_order_relaxed);
+
+    // Chunks are counted before they are pushed, s.t. a worker, which takes one of them, never decrements the count before it's incremented.
+    {
+      std::lock_guard<std::mutex> lock(idle_mutex);
+      queued_chunks.fetch_add(chunk_cnt, std::memory_order_relaxed);
+    }
+
+    // Start with a different worker for each job, s.t. small jobs don't always land on the first worker.
+    const size_t first = next_worker.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t i = 0; i < worker_cnt; i++) {
+      const size_t beg = (i * chunk_cnt) / worker_cnt;
+      const size_t end = ((i + 1) * chunk_cnt) / worker_cnt;
+      if (beg == end) {
+        continue;
+      }
+
+      auto& worker = *workers[(first + i) % worker_cnt];
+      std::lock_guard<std::mutex> lock(worker.queue_mutex);
+      for (size_t chunk = beg; chunk < end; chunk++) {
+        worker.queue.emplace_back(job, chunk);
+      }
+    }
+
+    idle_cv.notify_all();
+  }
+
+  // Pops a chunk from front of own queue, otherwise steals one from back of some other worker's queue.
+  bool next_chunk(const size_t id, std::pair<std::shared_ptr<job_t>, size_t>& chunk)
+  {
+    const size_t worker_cnt = workers.size();
+
+    for (size_t i = 0; i < worker_cnt; i++) {
+      auto& worker = *workers[(id + i) % worker_cnt];
+      std::lock_guard<std::mutex> lock(worker.queue_mutex);
+
+      if (!worker.queue.empty()) {
+        if (i == 0) {
+          chunk = std::move(worker.queue.front());
+          worker.queue.pop_front();
+        } else {
+          chunk = std::move(worker.queue.back());
+          worker.queue.pop_back();
+        }
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  void work(const size_t id)
+  {
+    auto& self = *workers[id];
+
+    while (true) {
+      std::pair<std::shared_ptr<job_t>, size_t> chunk{};
+
+      if (next_chunk(id, chunk)) {
+        queued_chunks.fetch_sub(1, std::memory_order_relaxed);
+
+        auto& job = *chunk.first;
+        const size_t beg = chunk.second * BATCH_LANES;
+        const size_t len = std::min(BATCH_LANES, job.item_cnt - beg);
+
+        try {
+          job.run(self, beg, len);
+        } catch (...) {
+          job.fail(std::current_exception());
+        }
+
+        if (job.pending_chunks.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+          // An exception thrown by the completion callback has nowhere left to go, so it's dropped, keeping the worker alive.
+          try {
+            job.complete(job.failure);
+          } catch (...) {
+          }
+        }
+        continue;
+      }
+
+      std::unique_lock<std::mutex> lock(idle_mutex);
+      idle_cv.wait(lock, [&]() { return stopping || (queued_chunks > 0); });
+      if (stopping && (queued_chunks == 0)) {
+        return;
+      }
+    }
+  }
+
+  std::vector<std::unique_ptr<worker_t>> workers;
+  std::atomic<size_t> next_worker{ 0 };
+
+  // Number of chunks submitted, but not yet taken by any worker. It's incremented while holding `idle_mutex`, on which idle workers wait,
+  // s.t. no wakeup is lost, and before the chunks are pushed to queues, while it's decremented by the worker, which has just taken a chunk,
+  // without holding the mutex. So it never wraps around, though a worker may briefly find it positive, while chunks are still being
+  // pushed, in which case it just looks for a chunk again.
+  std::mutex idle_mutex{};
+  std::condition_variable idle_cv{};
+  std::atomic<size_t> queued_chunks{ 0 };
+  bool stopping = false;
+};
+
+}
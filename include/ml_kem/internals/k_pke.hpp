@@ -1,10 +1,10 @@
 #pragma once
-#include "ml_kem/internals/math/field.hpp"
 #include "ml_kem/internals/poly/compression.hpp"
 #include "ml_kem/internals/poly/ntt.hpp"
 #include "ml_kem/internals/poly/poly_vec.hpp"
 #include "ml_kem/internals/poly/sampling.hpp"
 #include "ml_kem/internals/poly/serialize.hpp"
+#include "ml_kem/internals/utility/force_inline.hpp"
 #include "ml_kem/internals/utility/params.hpp"
 #include "ml_kem/internals/utility/utils.hpp"
 #include "sha3/sha3_512.hpp"
@@ -14,16 +14,105 @@
 #include <cstdint>
 #include <span>
 
+// Define `ML_KEM_STREAM_MATRIX` as 1, for never materializing public matrix A in key generation and encryption ( hence also in
+// encapsulation and decapsulation ). Instead it is expanded one row at a time, which is multiplied with the vector right away ( see
+// `ml_kem_utils::expand_matrix_multiply` ), shrinking the working set from k x k polynomials to k of them, at the cost of sampling
+// rows using fewer SHAKE128 lanes at once. Prepared public and secret keys still hold the expanded matrix. Enabled by default, when
+// `ML_KEM_LOW_STACK` is set.
+#ifndef ML_KEM_STREAM_MATRIX
+#define ML_KEM_STREAM_MATRIX ML_KEM_LOW_STACK
+#endif
+
 // Public Key Encryption Scheme
 namespace k_pke {
 
-// K-PKE key generation algorithm, generating byte serialized public key and secret keym given a 32 -bytes input seed `d`.
+// Returns compile-time computable number of coefficients in the buffer holding public matrix A, which either holds whole of it, or
+// a single row of it, when it is being streamed.
+forceinline constexpr size_t
+get_matrix_buf_len(const size_t k, const bool stream)
+{
+  return (stream ? 1 : k) * k * ml_kem_ntt::N;
+}
+
+// Scratch space for K-PKE routines, holding all polynomial vectors they compute, other than public matrix A and vector t. All of its
+// regions, but `u`, hold secret material, which is zeroized by the routine using it, right before returning. None of the routines
+// expect it to be initialized, so it can be reused across calls.
+template<size_t k>
+struct scratch_t
+{
+  // Secret vector s and its multiplication cache ( see `poly_vec_mulcache` ), used in key generation and decryption.
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N> s{};
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N / 2> s_cache{};
+
+  // Secret vector r and its multiplication cache, used in encryption.
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N> r{};
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N / 2> r_cache{};
+
+  // Noise vector e, used in key generation, or e1 followed by e2, used in encryption.
+  alignas(64) std::array<int16_t, (k + 1) * ml_kem_ntt::N> e{};
+
+  // Polynomials v, decoded message m and product t, used in encryption and decryption.
+  alignas(64) std::array<int16_t, ml_kem_ntt::N> v{};
+  alignas(64) std::array<int16_t, ml_kem_ntt::N> m{};
+  alignas(64) std::array<int16_t, ml_kem_ntt::N> t{};
+
+  // Vector u, which is either computed in encryption or decoded from cipher text in decryption. It's public.
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N> u{};
+};
+
+// Given seed ρ, secret vector s and noise vector e, both sampled in `scratch` ( see line 8-15 of algorithm 13 ), and a routine
+// computing product of matrix A with vector s ( see line 18 of algorithm 13 ), this routine computes vector t and byte serializes both
+// K-PKE keys. Matrix A is hidden behind `mul_A`, which is invoked as `mul_A(s, s_cache, t)`, s.t. it can either be already expanded
+// or be expanded on-the-fly. Secret regions of `scratch` are zeroized before returning.
+//
+// See line 16-20 of algorithm 13 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, typename mul_A_t>
+constexpr void
+keygen_sampled(std::span<const uint8_t, 32> rho,
+               mul_A_t&& mul_A,
+               std::span<uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey,
+               std::span<uint8_t, ml_kem_utils::get_pke_secret_key_len(k)> seckey,
+               std::span<int16_t, k * ml_kem_ntt::N> t_prime,
+               scratch_t<k>& scratch)
+  requires(ml_kem_params::check_k(k))
+{
+  auto s = std::span(scratch.s);
+  auto e = std::span(scratch.e).template first<k * ml_kem_ntt::N>();
+
+  ml_kem_utils::poly_vec_ntt<k>(s);
+  ml_kem_utils::poly_vec_ntt<k>(e);
+
+  ml_kem_utils::poly_vec_mulcache<k>(s, scratch.s_cache);
+
+  mul_A(std::span<const int16_t, k * ml_kem_ntt::N>(s), std::span<const int16_t, k * ml_kem_ntt::N / 2>(scratch.s_cache), t_prime);
+  ml_kem_utils::poly_vec_add_to<k>(e, t_prime);
+
+  constexpr size_t pubkey_offset = k * 12 * 32;
+  auto encoded_t_prime_in_pubkey = pubkey.template subspan<0, pubkey_offset>();
+  auto rho_in_pubkey = pubkey.template subspan<pubkey_offset, 32>();
+
+  ml_kem_utils::poly_vec_encode<k, 12>(t_prime, encoded_t_prime_in_pubkey);
+  std::copy(rho.begin(), rho.end(), rho_in_pubkey.begin());
+  ml_kem_utils::poly_vec_encode<k, 12>(s, seckey);
+
+  ml_kem_utils::secure_zeroize(scratch.s);
+  ml_kem_utils::secure_zeroize(scratch.s_cache);
+  ml_kem_utils::secure_zeroize(scratch.e);
+}
+
+// K-PKE key generation algorithm, generating byte serialized public key and secret keym given a 32 -bytes input seed `d`. Public
+// matrix A ( or a row of it, when streamed ) and vector t are expanded in supplied buffers, while all secret material is kept in
+// `scratch`.
+//
 // See algorithm 13 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
-template<size_t k, size_t eta1>
+template<size_t k, size_t eta1, bool stream = ML_KEM_STREAM_MATRIX != 0>
 constexpr void
 keygen(std::span<const uint8_t, 32> d,
        std::span<uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey,
-       std::span<uint8_t, ml_kem_utils::get_pke_secret_key_len(k)> seckey)
+       std::span<uint8_t, ml_kem_utils::get_pke_secret_key_len(k)> seckey,
+       std::span<int16_t, get_matrix_buf_len(k, stream)> A_prime,
+       std::span<int16_t, k * ml_kem_ntt::N> t_prime,
+       scratch_t<k>& scratch)
   requires(ml_kem_params::check_keygen_params(k, eta1))
 {
   std::array<uint8_t, 64> g_out{};
@@ -42,164 +131,300 @@ keygen(std::span<const uint8_t, 32> d,
   const auto rho = g_out_span.template subspan<0, 32>();
   const auto sigma = g_out_span.template subspan<rho.size(), 32>();
 
-  std::array<ml_kem_field::zq_t, k * k * ml_kem_ntt::N> A_prime{};
-  ml_kem_utils::generate_matrix<k, false>(A_prime, rho);
-
-  uint8_t N = 0;
-
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> s{};
-  ml_kem_utils::generate_vector<k, eta1>(s, sigma, N);
-  N += k;
-
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> e{};
-  ml_kem_utils::generate_vector<k, eta1>(e, sigma, N);
-  N += k;
+  constexpr uint8_t N = 0;
 
-  ml_kem_utils::poly_vec_ntt<k>(s);
-  ml_kem_utils::poly_vec_ntt<k>(e);
+  // Both s and e are sampled together, using nonces N, N+1, ..., N+2k-1, in that order.
+  auto s = std::span(scratch.s);
+  auto e = std::span(scratch.e).template first<k * ml_kem_ntt::N>();
+  ml_kem_utils::generate_vectors<k, eta1, k, eta1>(s, e, sigma, N);
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> t_prime{};
-
-  ml_kem_utils::matrix_multiply<k, k, k, 1>(A_prime, s, t_prime);
-  ml_kem_utils::poly_vec_add_to<k>(e, t_prime);
+  using vec_t = std::span<const int16_t, k * ml_kem_ntt::N>;
+  using cache_t = std::span<const int16_t, k * ml_kem_ntt::N / 2>;
+  using out_t = std::span<int16_t, k * ml_kem_ntt::N>;
 
-  constexpr size_t pubkey_offset = k * 12 * 32;
-  auto encoded_t_prime_in_pubkey = pubkey.template subspan<0, pubkey_offset>();
-  auto rho_in_pubkey = pubkey.template subspan<pubkey_offset, 32>();
+  if constexpr (stream) {
+    const auto mul_A = [&](vec_t s_prime, cache_t s_cache, out_t t) { ml_kem_utils::expand_matrix_multiply<k, false>(rho, s_prime, s_cache, t, A_prime); };
+    keygen_sampled<k>(rho, mul_A, pubkey, seckey, t_prime, scratch);
+  } else {
+    ml_kem_utils::generate_matrix<k, false>(A_prime, rho);
 
-  ml_kem_utils::poly_vec_encode<k, 12>(t_prime, encoded_t_prime_in_pubkey);
-  std::copy(rho.begin(), rho.end(), rho_in_pubkey.begin());
-  ml_kem_utils::poly_vec_encode<k, 12>(s, seckey);
+    const auto mul_A = [&](vec_t s_prime, cache_t s_cache, out_t t) { ml_kem_utils::matrix_multiply<k, k, k, 1>(A_prime, s_prime, s_cache, t); };
+    keygen_sampled<k>(rho, mul_A, pubkey, seckey, t_prime, scratch);
+  }
 
   ml_kem_utils::secure_zeroize(g_out);
-  ml_kem_utils::secure_zeroize(s);
-  ml_kem_utils::secure_zeroize(e);
 }
 
-// Given a *valid* K-PKE public key, 32 -bytes message ( to be encrypted ) and 32 -bytes random coin
-// ( from where all randomness is deterministically sampled ), this routine encrypts message using
-// K-PKE encryption algorithm, computing compressed cipher text.
+// Given a K-PKE public key, this routine decodes its NTT domain vector t ( see line 2 of algorithm 14 ).
 //
 // If modulus check, as described in point (2) of section 7.2 of ML-KEM standard, fails, it returns false.
-//
-// See algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
-template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+template<size_t k>
 [[nodiscard("Use result of modulus check on public key")]] constexpr bool
-encrypt(std::span<const uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey,
-        std::span<const uint8_t, 32> msg,
-        std::span<const uint8_t, 32> rcoin,
-        std::span<uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt)
-  requires(ml_kem_params::check_encrypt_params(k, eta1, eta2, du, dv))
+decode_pubkey(std::span<const uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey, std::span<int16_t, k * ml_kem_ntt::N> t_prime)
+  requires(ml_kem_params::check_k(k))
 {
   constexpr size_t pkoff = k * 12 * 32;
   auto encoded_t_prime_in_pubkey = pubkey.template subspan<0, pkoff>();
-  auto rho = pubkey.template subspan<pkoff, 32>();
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> t_prime{};
-  std::array<uint8_t, encoded_t_prime_in_pubkey.size()> encoded_tprime{};
-
-  ml_kem_utils::poly_vec_decode<k, 12>(encoded_t_prime_in_pubkey, t_prime);
-  ml_kem_utils::poly_vec_encode<k, 12>(t_prime, encoded_tprime);
+  // Re-encoding decoded t_prime reproduces the public key bytes iff none of the decoded coefficients is ≥ q, which is checked while decoding.
+  const auto non_canonical = ml_kem_utils::poly_vec_decode_checked<k>(encoded_t_prime_in_pubkey, t_prime);
+  return non_canonical == 0U;
+}
 
-  using encoded_pkey_t = std::span<const uint8_t, encoded_t_prime_in_pubkey.size()>;
-  const auto are_equal = ml_kem_utils::ct_memcmp(encoded_pkey_t(encoded_t_prime_in_pubkey), encoded_pkey_t(encoded_tprime));
-  if (are_equal == 0U) {
+// Given a K-PKE public key, this routine decodes its NTT domain vector t ( see line 2 of algorithm 14 ) and expands transpose of
+// matrix A from its seed ρ ( see line 3-8 of algorithm 14 ), i.e. all of the encryption work which depends on the public key only.
+//
+// If modulus check, as described in point (2) of section 7.2 of ML-KEM standard, fails, it returns false, without expanding the matrix.
+//
+// See algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k>
+[[nodiscard("Use result of modulus check on public key")]] constexpr bool
+prepare_pubkey(std::span<const uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey,
+               std::span<int16_t, k * ml_kem_ntt::N> t_prime,
+               std::span<int16_t, k * k * ml_kem_ntt::N> A_prime)
+  requires(ml_kem_params::check_k(k))
+{
+  if (!decode_pubkey<k>(pubkey, t_prime)) {
     // Got an invalid public key
     return false;
   }
 
-  std::array<ml_kem_field::zq_t, k * k * ml_kem_ntt::N> A_prime{};
-  ml_kem_utils::generate_matrix<k, true>(A_prime, rho);
-
-  uint8_t N = 0;
-
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> r{};
-  ml_kem_utils::generate_vector<k, eta1>(r, rcoin, N);
-  N += k;
+  constexpr size_t pkoff = k * 12 * 32;
+  auto rho = pubkey.template subspan<pkoff, 32>();
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> e1{};
-  ml_kem_utils::generate_vector<k, eta2>(e1, rcoin, N);
-  N += k;
+  ml_kem_utils::generate_matrix<k, true>(A_prime, rho);
+  return true;
+}
 
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> e2{};
-  ml_kem_utils::generate_vector<1, eta2>(e2, rcoin, N);
+// Given decoded NTT domain vector t of a public key, a routine computing product of transpose of matrix A with vector r ( see line 19
+// of algorithm 14 ) and 32 -bytes message ( to be encrypted ), this routine encrypts message using K-PKE encryption algorithm, computing
+// compressed cipher text, where vector r, error vector e1 and error polynomial e2 are already sampled in `scratch` ( see line 9-17 of
+// algorithm 14 ). Matrix A is hidden behind `mul_A`, which is invoked as `mul_A(r, r_cache, u)`, s.t. it can either be already
+// expanded or be expanded on-the-fly. Secret regions of `scratch` are zeroized before returning.
+//
+// See line 18-23 of algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t du, size_t dv, typename mul_A_t>
+constexpr void
+encrypt_sampled(std::span<const int16_t, k * ml_kem_ntt::N> t_prime,
+                mul_A_t&& mul_A,
+                std::span<const uint8_t, 32> msg,
+                std::span<uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+                scratch_t<k>& scratch)
+  requires(ml_kem_params::check_decrypt_params(k, du, dv))
+{
+  auto r = std::span(scratch.r);
+  auto e1 = std::span(scratch.e).template first<k * ml_kem_ntt::N>();
+  auto e2 = std::span(scratch.e).template last<ml_kem_ntt::N>();
 
   ml_kem_utils::poly_vec_ntt<k>(r);
+  ml_kem_utils::poly_vec_mulcache<k>(r, scratch.r_cache);
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> u{};
+  auto u = std::span(scratch.u);
+  auto v = std::span(scratch.v);
+  auto m = std::span(scratch.m);
 
-  ml_kem_utils::matrix_multiply<k, k, k, 1>(A_prime, r, u);
+  mul_A(std::span<const int16_t, k * ml_kem_ntt::N>(r), std::span<const int16_t, k * ml_kem_ntt::N / 2>(scratch.r_cache), u);
   ml_kem_utils::poly_vec_intt<k>(u);
   ml_kem_utils::poly_vec_add_to<k>(e1, u);
 
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> v{};
-
-  ml_kem_utils::matrix_multiply<1, k, k, 1>(t_prime, r, v);
+  ml_kem_utils::matrix_multiply<1, k, k, 1>(t_prime, r, scratch.r_cache, v);
   ml_kem_utils::poly_vec_intt<1>(v);
   ml_kem_utils::poly_vec_add_to<1>(e2, v);
 
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> m{};
-  ml_kem_utils::decode<1>(msg, m);
-  ml_kem_utils::poly_decompress<1>(m);
+  ml_kem_utils::decode_decompress<1>(msg, m);
   ml_kem_utils::poly_vec_add_to<1>(m, v);
 
   constexpr size_t ctxt_offset = k * du * 32;
   auto polyvec_u_in_ctxt = ctxt.template first<ctxt_offset>();
   auto poly_v_in_ctxt = ctxt.template last<dv * 32>();
 
-  ml_kem_utils::poly_vec_compress<k, du>(u);
-  ml_kem_utils::poly_vec_encode<k, du>(u, polyvec_u_in_ctxt);
+  ml_kem_utils::poly_vec_compress_encode<k, du>(u, polyvec_u_in_ctxt);
+  ml_kem_utils::compress_encode<dv>(v, poly_v_in_ctxt);
 
-  ml_kem_utils::poly_compress<dv>(v);
-  ml_kem_utils::encode<dv>(v, poly_v_in_ctxt);
+  ml_kem_utils::secure_zeroize(scratch.r);
+  ml_kem_utils::secure_zeroize(scratch.r_cache);
+  ml_kem_utils::secure_zeroize(scratch.e);
+  ml_kem_utils::secure_zeroize(scratch.v);
+  ml_kem_utils::secure_zeroize(scratch.m);
+}
 
-  ml_kem_utils::secure_zeroize(r);
-  ml_kem_utils::secure_zeroize(e1);
-  ml_kem_utils::secure_zeroize(e2);
-  ml_kem_utils::secure_zeroize(m);
+// Given decoded NTT domain vector t of a public key, a routine computing product of transpose of matrix A with vector r ( see line 19
+// of algorithm 14 ), 32 -bytes message ( to be encrypted ) and 32 -bytes random coin ( from where all randomness is deterministically
+// sampled ), this routine encrypts message using K-PKE encryption algorithm, computing compressed cipher text. Matrix A is hidden
+// behind `mul_A`, which is invoked as `mul_A(r, r_cache, u)`, s.t. it can either be already expanded or be expanded on-the-fly.
+//
+// See line 9-23 of algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, typename mul_A_t>
+constexpr void
+encrypt_with(std::span<const int16_t, k * ml_kem_ntt::N> t_prime,
+             mul_A_t&& mul_A,
+             std::span<const uint8_t, 32> msg,
+             std::span<const uint8_t, 32> rcoin,
+             std::span<uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+             scratch_t<k>& scratch)
+  requires(ml_kem_params::check_encrypt_params(k, eta1, eta2, du, dv))
+{
+  constexpr uint8_t N = 0;
+
+  // r, e1 and e2 are sampled together, using nonces N, N+1, ..., N+2k, in that order. As both e1 and e2 are sampled from Bη2,
+  // they are held next to each other.
+  auto r = std::span(scratch.r);
+  ml_kem_utils::generate_vectors<k, eta1, k + 1, eta2>(r, scratch.e, rcoin, N);
+
+  encrypt_sampled<k, du, dv>(t_prime, mul_A, msg, ctxt, scratch);
+}
+
+// Given a public key, already decoded and expanded by `prepare_pubkey`, 32 -bytes message ( to be encrypted ) and 32 -bytes random
+// coin ( from where all randomness is deterministically sampled ), this routine encrypts message using K-PKE encryption algorithm,
+// computing compressed cipher text.
+//
+// See line 9-23 of algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+constexpr void
+encrypt_prepared(std::span<const int16_t, k * ml_kem_ntt::N> t_prime,
+                 std::span<const int16_t, k * k * ml_kem_ntt::N> A_prime,
+                 std::span<const uint8_t, 32> msg,
+                 std::span<const uint8_t, 32> rcoin,
+                 std::span<uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+                 scratch_t<k>& scratch)
+  requires(ml_kem_params::check_encrypt_params(k, eta1, eta2, du, dv))
+{
+  using vec_t = std::span<const int16_t, k * ml_kem_ntt::N>;
+  using cache_t = std::span<const int16_t, k * ml_kem_ntt::N / 2>;
+  using out_t = std::span<int16_t, k * ml_kem_ntt::N>;
+
+  const auto mul_A = [&](vec_t r, cache_t r_cache, out_t u) { ml_kem_utils::matrix_multiply<k, k, k, 1>(A_prime, r, r_cache, u); };
+  encrypt_with<k, eta1, eta2, du, dv>(t_prime, mul_A, msg, rcoin, ctxt, scratch);
+}
+
+// Given a *valid* K-PKE public key, 32 -bytes message ( to be encrypted ) and 32 -bytes random coin
+// ( from where all randomness is deterministically sampled ), this routine encrypts message using
+// K-PKE encryption algorithm, computing compressed cipher text. Public matrix A ( or a row of it, when
+// streamed ) and vector t are expanded in supplied buffers.
+//
+// If modulus check, as described in point (2) of section 7.2 of ML-KEM standard, fails, it returns false.
+//
+// See algorithm 14 of K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, bool stream = ML_KEM_STREAM_MATRIX != 0>
+[[nodiscard("Use result of modulus check on public key")]] constexpr bool
+encrypt(std::span<const uint8_t, ml_kem_utils::get_pke_public_key_len(k)> pubkey,
+        std::span<const uint8_t, 32> msg,
+        std::span<const uint8_t, 32> rcoin,
+        std::span<uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+        std::span<int16_t, get_matrix_buf_len(k, stream)> A_prime,
+        std::span<int16_t, k * ml_kem_ntt::N> t_prime,
+        scratch_t<k>& scratch)
+  requires(ml_kem_params::check_encrypt_params(k, eta1, eta2, du, dv))
+{
+  if constexpr (stream) {
+    if (!decode_pubkey<k>(pubkey, t_prime)) {
+      return false;
+    }
+
+    using vec_t = std::span<const int16_t, k * ml_kem_ntt::N>;
+    using cache_t = std::span<const int16_t, k * ml_kem_ntt::N / 2>;
+    using out_t = std::span<int16_t, k * ml_kem_ntt::N>;
+
+    const auto rho = pubkey.template last<32>();
+    const auto mul_A = [&](vec_t r, cache_t r_cache, out_t u) { ml_kem_utils::expand_matrix_multiply<k, true>(rho, r, r_cache, u, A_prime); };
+    encrypt_with<k, eta1, eta2, du, dv>(t_prime, mul_A, msg, rcoin, ctxt, scratch);
+  } else {
+    if (!prepare_pubkey<k>(pubkey, t_prime, A_prime)) {
+      return false;
+    }
+
+    encrypt_prepared<k, eta1, eta2, du, dv>(t_prime, A_prime, msg, rcoin, ctxt, scratch);
+  }
 
   return true;
 }
 
-// Given K-PKE secret key and cipher text, this routine recovers 32 -bytes plain text which
-// was encrypted using K-PKE public key i.e. associated with this secret key.
+// Given K-PKE cipher text, this routine decodes and decompresses vector u, which is then transformed to NTT domain, and polynomial v,
+// s.t. the cipher text can be decrypted by many secret keys, without decoding it again. Both u and v are public.
 //
-// See algorithm 15 defined in K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+// See line 3-4 of algorithm 15 defined in K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
 template<size_t k, size_t du, size_t dv>
 constexpr void
-decrypt(std::span<const uint8_t, ml_kem_utils::get_pke_secret_key_len(k)> seckey,
-        std::span<const uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
-        std::span<uint8_t, 32> ptxt)
+decode_cipher_text(std::span<const uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+                   std::span<int16_t, k * ml_kem_ntt::N> u_prime,
+                   std::span<int16_t, ml_kem_ntt::N> v)
   requires(ml_kem_params::check_decrypt_params(k, du, dv))
 {
   constexpr size_t ctxt_offset = k * du * 32;
   auto polyvec_u_in_ctxt = ctxt.template subspan<0, ctxt_offset>();
   auto poly_v_in_ctxt = ctxt.template subspan<ctxt_offset, dv * 32>();
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> u{};
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> v{};
+  ml_kem_utils::poly_vec_decode_decompress<k, du>(polyvec_u_in_ctxt, u_prime);
+  ml_kem_utils::decode_decompress<dv>(poly_v_in_ctxt, v);
 
-  ml_kem_utils::poly_vec_decode<k, du>(polyvec_u_in_ctxt, u);
-  ml_kem_utils::poly_vec_decompress<k, du>(u);
+  ml_kem_utils::poly_vec_ntt<k>(u_prime);
+}
 
-  ml_kem_utils::decode<dv>(poly_v_in_ctxt, v);
-  ml_kem_utils::poly_decompress<dv>(v);
+// Given K-PKE secret key, already decoded into NTT domain vector s, along with its cache of products with twiddle factors, and cipher
+// text, already decoded by `decode_cipher_text`, with vector u in NTT domain and polynomial v placed in `scratch.v`, this routine recovers
+// 32 -bytes plain text. Polynomial v is consumed, it is overwritten and then zeroized.
+//
+// See line 5-7 of algorithm 15 defined in K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k>
+constexpr void
+decrypt_decoded(std::span<const int16_t, k * ml_kem_ntt::N> s_prime,
+                std::span<const int16_t, k * ml_kem_ntt::N / 2> s_cache,
+                std::span<const int16_t, k * ml_kem_ntt::N> u_prime,
+                std::span<uint8_t, 32> ptxt,
+                scratch_t<k>& scratch)
+  requires(ml_kem_params::check_k(k))
+{
+  auto v = std::span(scratch.v);
+  auto t = std::span(scratch.t);
 
-  std::array<ml_kem_field::zq_t, k * ml_kem_ntt::N> s_prime{};
-  ml_kem_utils::poly_vec_decode<k, 12>(seckey, s_prime);
+  // As polynomial multiplication commutes, uᵀ ∘ s is computed instead of sᵀ ∘ u, s.t. cached products of s can be used.
+  ml_kem_utils::matrix_multiply<1, k, k, 1>(u_prime, s_prime, s_cache, t);
+  ml_kem_utils::poly_vec_intt<1>(t);
+  ml_kem_utils::poly_vec_sub_from<1>(t, v);
 
-  ml_kem_utils::poly_vec_ntt<k>(u);
+  ml_kem_utils::compress_encode<1>(v, ptxt);
 
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> t{};
+  ml_kem_utils::secure_zeroize(scratch.v);
+  ml_kem_utils::secure_zeroize(scratch.t);
+}
 
-  ml_kem_utils::matrix_multiply<1, k, k, 1>(s_prime, u, t);
-  ml_kem_utils::poly_vec_intt<1>(t);
-  ml_kem_utils::poly_vec_sub_from<1>(t, v);
+// Given K-PKE secret key, already decoded into NTT domain vector s, along with its cache of products with twiddle factors ( see
+// `poly_vec_mulcache` ), and cipher text, this routine recovers 32 -bytes plain text which was encrypted using K-PKE public key, associated
+// with this secret key.
+//
+// See line 3-7 of algorithm 15 defined in K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t du, size_t dv>
+constexpr void
+decrypt_prepared(std::span<const int16_t, k * ml_kem_ntt::N> s_prime,
+                 std::span<const int16_t, k * ml_kem_ntt::N / 2> s_cache,
+                 std::span<const uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+                 std::span<uint8_t, 32> ptxt,
+                 scratch_t<k>& scratch)
+  requires(ml_kem_params::check_decrypt_params(k, du, dv))
+{
+  decode_cipher_text<k, du, dv>(ctxt, scratch.u, scratch.v);
+  decrypt_decoded<k>(s_prime, s_cache, scratch.u, ptxt, scratch);
+}
+
+// Given K-PKE secret key and cipher text, this routine recovers 32 -bytes plain text which
+// was encrypted using K-PKE public key i.e. associated with this secret key.
+//
+// See algorithm 15 defined in K-PKE specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t du, size_t dv>
+constexpr void
+decrypt(std::span<const uint8_t, ml_kem_utils::get_pke_secret_key_len(k)> seckey,
+        std::span<const uint8_t, ml_kem_utils::get_pke_cipher_text_len(k, du, dv)> ctxt,
+        std::span<uint8_t, 32> ptxt,
+        scratch_t<k>& scratch)
+  requires(ml_kem_params::check_decrypt_params(k, du, dv))
+{
+  ml_kem_utils::poly_vec_decode<k, 12>(seckey, scratch.s);
+  ml_kem_utils::poly_vec_mulcache<k>(scratch.s, scratch.s_cache);
 
-  ml_kem_utils::poly_compress<1>(v);
-  ml_kem_utils::encode<1>(v, ptxt);
+  decrypt_prepared<k, du, dv>(scratch.s, scratch.s_cache, ctxt, ptxt, scratch);
 
-  ml_kem_utils::secure_zeroize(s_prime);
+  ml_kem_utils::secure_zeroize(scratch.s);
+  ml_kem_utils::secure_zeroize(scratch.s_cache);
 }
 
 }
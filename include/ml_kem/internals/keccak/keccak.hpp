@@ -0,0 +1,127 @@
+#pragma once
+#include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Keccak-f[1600] permutation, used by multi-lane SHAKE implementations, which sample matrix A and noise vectors from many
+// independent XOF streams at once. Single-stream hashing is still done using the `sha3` dependency.
+//
+// See section 3 of SHA3 specification https://doi.org/10.6028/NIST.FIPS.202.
+namespace ml_kem_keccak {
+
+// Keccak-f[1600] state consists of 25 lanes, each of 64 -bits.
+inline constexpr size_t LANE_CNT = 25;
+inline constexpr size_t NUM_ROUNDS = 24;
+
+// Round constants, applied to lane (0, 0) during ι step mapping.
+inline constexpr std::array<uint64_t, NUM_ROUNDS> ROUND_CONSTANTS = {
+  0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL, 0x000000000000808bULL, 0x0000000080000001ULL,
+  0x8000000080008081ULL, 0x8000000000008009ULL, 0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+  0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL, 0x8000000000008002ULL, 0x8000000000000080ULL,
+  0x000000000000800aULL, 0x800000008000000aULL, 0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL,
+};
+
+// Left rotation offsets of lane (x, y), indexed by x + 5 * y, applied during ρ step mapping.
+inline constexpr std::array<int, LANE_CNT> ROTATION_OFFSETS = { 0,  1,  62, 28, 27, 36, 44, 6,  55, 20, 3,  10, 43,
+                                                                25, 39, 41, 45, 15, 21, 8,  18, 2,  61, 56, 14 };
+
+// Index of lane, where lane (x, y) is moved to, during π step mapping, indexed by x + 5 * y.
+inline constexpr std::array<size_t, LANE_CNT> PI_INDICES = []() -> auto {
+  std::array<size_t, LANE_CNT> res{};
+  for (size_t y = 0; y < 5; y++) {
+    for (size_t x = 0; x < 5; x++) {
+      res[x + 5 * y] = y + 5 * (((2 * x) + (3 * y)) % 5);
+    }
+  }
+  return res;
+}();
+
+// Given a Keccak-f[1600] state, this routine applies all 24 rounds of the permutation on it, in-place.
+forceinline constexpr void
+permute(std::span<uint64_t, LANE_CNT> state)
+{
+  for (size_t r = 0; r < NUM_ROUNDS; r++) {
+    // θ
+    std::array<uint64_t, 5> c{};
+    for (size_t x = 0; x < 5; x++) {
+      c[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+    }
+    for (size_t x = 0; x < 5; x++) {
+      const uint64_t d = c[(x + 4) % 5] ^ std::rotl(c[(x + 1) % 5], 1);
+      for (size_t y = 0; y < 5; y++) {
+        state[x + 5 * y] ^= d;
+      }
+    }
+
+    // ρ and π
+    std::array<uint64_t, LANE_CNT> b{};
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      b[PI_INDICES[i]] = std::rotl(state[i], ROTATION_OFFSETS[i]);
+    }
+
+    // χ
+    for (size_t y = 0; y < 5; y++) {
+      for (size_t x = 0; x < 5; x++) {
+        state[x + 5 * y] = b[x + 5 * y] ^ (~b[((x + 1) % 5) + 5 * y] & b[((x + 2) % 5) + 5 * y]);
+      }
+    }
+
+    // ι
+    state[0] ^= ROUND_CONSTANTS[r];
+  }
+}
+
+// Given `lanes` -many interleaved Keccak-f[1600] states s.t. lane i of state j lives at index i * lanes + j, this routine applies all
+// 24 rounds of the permutation on each of them, in-place. Each step is computed on all states, before moving to the next one, which
+// exposes independent operations to the CPU ( and to the auto-vectorizer ), when no explicitly vectorized implementation is usable.
+template<size_t lanes>
+forceinline constexpr void
+permute_xn(std::span<uint64_t, LANE_CNT * lanes> state)
+{
+  for (size_t r = 0; r < NUM_ROUNDS; r++) {
+    // θ
+    std::array<uint64_t, 5 * lanes> c{};
+    for (size_t x = 0; x < 5; x++) {
+      for (size_t j = 0; j < lanes; j++) {
+        c[x * lanes + j] = state[x * lanes + j] ^ state[(x + 5) * lanes + j] ^ state[(x + 10) * lanes + j] ^ state[(x + 15) * lanes + j] ^
+                           state[(x + 20) * lanes + j];
+      }
+    }
+    for (size_t x = 0; x < 5; x++) {
+      for (size_t j = 0; j < lanes; j++) {
+        const uint64_t d = c[((x + 4) % 5) * lanes + j] ^ std::rotl(c[((x + 1) % 5) * lanes + j], 1);
+        for (size_t y = 0; y < 5; y++) {
+          state[(x + 5 * y) * lanes + j] ^= d;
+        }
+      }
+    }
+
+    // ρ and π
+    std::array<uint64_t, LANE_CNT * lanes> b{};
+    for (size_t i = 0; i < LANE_CNT; i++) {
+      for (size_t j = 0; j < lanes; j++) {
+        b[PI_INDICES[i] * lanes + j] = std::rotl(state[i * lanes + j], ROTATION_OFFSETS[i]);
+      }
+    }
+
+    // χ
+    for (size_t y = 0; y < 5; y++) {
+      for (size_t x = 0; x < 5; x++) {
+        for (size_t j = 0; j < lanes; j++) {
+          state[(x + 5 * y) * lanes + j] =
+            b[(x + 5 * y) * lanes + j] ^ (~b[(((x + 1) % 5) + 5 * y) * lanes + j] & b[(((x + 2) % 5) + 5 * y) * lanes + j]);
+        }
+      }
+    }
+
+    // ι
+    for (size_t j = 0; j < lanes; j++) {
+      state[j] ^= ROUND_CONSTANTS[r];
+    }
+  }
+}
+
+}
@@ -0,0 +1,167 @@
+#pragma once
+#include "ml_kem/internals/arch/avx2/keccak.hpp"
+#include "ml_kem/internals/arch/avx512/keccak.hpp"
+#include "ml_kem/internals/keccak/keccak.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
+#include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+namespace ml_kem_keccak {
+
+// Multi-lane SHAKE{128, 256} XOF, computing `lanes` -many independent sponges in lock-step, each absorbing a message of same length
+// and producing output of same length. Keccak-f[1600] states are kept interleaved, s.t. state lane i of sponge j lives at index
+// i * lanes + j, which lets the permutation be computed on all sponges at once using SIMD registers, when executing CPU allows it.
+// Output of each lane is bit-identical to what the single-lane SHAKE{128, 256} would produce for the same input.
+//
+// As SHA3-{256, 512} differ from SHAKE only in the domain separator and in squeezing a fixed length digest, which fits in a single
+// block, they are computed using the same sponge, instantiated with `domain_separator` = 0x06.
+//
+// See section 6.1 and 6.2 of SHA3 specification https://doi.org/10.6028/NIST.FIPS.202.
+template<size_t lanes, size_t rate, uint8_t domain_separator = 0x1f>
+  requires((lanes > 1) && (rate > 0) && (rate < LANE_CNT * sizeof(uint64_t)) && (rate % sizeof(uint64_t) == 0))
+struct shake_xn_t
+{
+private:
+  static constexpr uint8_t DOMAIN_SEPARATOR = domain_separator;
+
+  std::array<uint64_t, LANE_CNT * lanes> state{};
+  size_t offset = 0;
+  size_t squeezable = 0;
+  bool finalized = false;
+
+  // Applies Keccak-f[1600] permutation on all interleaved states.
+  forceinline constexpr void permute()
+  {
+#if ML_KEM_X86_SIMD
+    if (!std::is_constant_evaluated()) {
+      if constexpr (lanes == avx512::LANES) {
+        if (ml_kem_cpu::has_avx512()) {
+          avx512::permute_x8(state);
+          return;
+        }
+      }
+      if constexpr (lanes == avx2::LANES) {
+        if (ml_kem_cpu::has_avx2()) {
+          avx2::permute_x4(state);
+          return;
+        }
+      }
+    }
+#endif
+
+    permute_xn<lanes>(state);
+  }
+
+  // XORs byte `byte` into position `pos` ( < rate ) of the state of lane `j`.
+  forceinline constexpr void xor_byte(const size_t j, const size_t pos, const uint8_t byte)
+  {
+    const size_t shift = (pos % sizeof(uint64_t)) * std::numeric_limits<uint8_t>::digits;
+    state[(pos / sizeof(uint64_t)) * lanes + j] ^= static_cast<uint64_t>(byte) << shift;
+  }
+
+public:
+  static constexpr size_t RATE = rate;
+
+  // Given `lanes` -many messages, each of same byte length, this routine absorbs them into respective sponges. It can be called
+  // arbitrary number of times, before the sponges are finalized.
+  constexpr void absorb(const std::array<std::span<const uint8_t>, lanes>& msgs)
+  {
+    if (finalized) {
+      return;
+    }
+
+    const size_t mlen = msgs[0].size();
+    for (size_t b = 0; b < mlen; b++) {
+      for (size_t j = 0; j < lanes; j++) {
+        xor_byte(j, offset, msgs[j][b]);
+      }
+
+      offset++;
+      if (offset == rate) {
+        permute();
+        offset = 0;
+      }
+    }
+  }
+
+  // Pads the absorbed messages and prepares the sponges for squeezing.
+  constexpr void finalize()
+  {
+    if (finalized) {
+      return;
+    }
+
+    for (size_t j = 0; j < lanes; j++) {
+      xor_byte(j, offset, DOMAIN_SEPARATOR);
+      xor_byte(j, rate - 1, 0x80);
+    }
+
+    permute();
+
+    offset = 0;
+    squeezable = rate;
+    finalized = true;
+  }
+
+  // Given `lanes` -many output buffers, each of same byte length, this routine squeezes next bytes out of respective sponges. It can
+  // be called arbitrary number of times, after the sponges are finalized.
+  constexpr void squeeze(const std::array<std::span<uint8_t>, lanes>& outs)
+  {
+    if (!finalized) {
+      return;
+    }
+
+    const size_t olen = outs[0].size();
+    size_t b = 0;
+
+    while (b < olen) {
+      if (squeezable == 0) {
+        permute();
+        squeezable = rate;
+      }
+
+      const size_t pos = rate - squeezable;
+
+      if (((pos % sizeof(uint64_t)) == 0) && ((olen - b) >= sizeof(uint64_t))) {
+        // Whole state lane can be copied out of each sponge.
+        for (size_t j = 0; j < lanes; j++) {
+          const uint64_t word = state[(pos / sizeof(uint64_t)) * lanes + j];
+          for (size_t k = 0; k < sizeof(uint64_t); k++) {
+            outs[j][b + k] = static_cast<uint8_t>(word >> (k * std::numeric_limits<uint8_t>::digits));
+          }
+        }
+
+        b += sizeof(uint64_t);
+        squeezable -= sizeof(uint64_t);
+      } else {
+        const size_t shift = (pos % sizeof(uint64_t)) * std::numeric_limits<uint8_t>::digits;
+        for (size_t j = 0; j < lanes; j++) {
+          outs[j][b] = static_cast<uint8_t>(state[(pos / sizeof(uint64_t)) * lanes + j] >> shift);
+        }
+
+        b++;
+        squeezable--;
+      }
+    }
+  }
+};
+
+// 4-way and 8-way SHAKE128 and SHAKE256, matching the single-lane `shake128::shake128_t` and `shake256::shake256_t` respectively.
+using shake128_x4_t = shake_xn_t<4, 168>;
+using shake256_x4_t = shake_xn_t<4, 136>;
+using shake128_x8_t = shake_xn_t<8, 168>;
+using shake256_x8_t = shake_xn_t<8, 136>;
+
+// 4-way and 8-way SHA3-256 and SHA3-512, matching `sha3_256::sha3_256_t` and `sha3_512::sha3_512_t` respectively, when squeezed for
+// 32 and 64 -bytes respectively.
+using sha3_256_x4_t = shake_xn_t<4, 136, 0x06>;
+using sha3_512_x4_t = shake_xn_t<4, 72, 0x06>;
+using sha3_256_x8_t = shake_xn_t<8, 136, 0x06>;
+using sha3_512_x8_t = shake_xn_t<8, 72, 0x06>;
+
+}
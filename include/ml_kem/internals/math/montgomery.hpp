@@ -0,0 +1,94 @@
+#pragma once
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
+#include <cstdint>
+
+// Arithmetic over Z_q | q = 3329, on signed 16 -bit representatives, used internally by NTT, base case multiplication and matrix
+// multiplication. Multiplication by a constant is performed using signed Montgomery multiplication, with R = 2^16, where the
+// constant is kept in its Montgomery form i.e. multiplied by R. See https://eprint.iacr.org/2018/039 for a description of the technique.
+//
+// A polynomial coefficient is represented by any int16 value congruent to it modulo q, with bounds on its absolute value being
+// tracked by the kernels consuming it. It's brought back to its canonical form, which is what `zq_t` always holds, at
+// serialization and compression boundaries. Each routine here computes exactly what its vectorized counterpart does.
+namespace ml_kem_field {
+
+// Ml_kem Prime Field Modulus, as a signed 16 -bit integer.
+inline constexpr int16_t Q16 = static_cast<int16_t>(Q);
+
+// q^-1 mod 2^16, interpreted as a signed 16 -bit integer.
+inline constexpr int16_t QINV = -3327;
+static_assert(static_cast<uint16_t>(Q * static_cast<uint16_t>(QINV)) == 1, "QINV must be inverse of Q modulo 2^16");
+
+// round(2^26 / q), used for Barrett reduction of signed 16 -bit integers.
+inline constexpr int16_t BARRETT_V = static_cast<int16_t>(((1U << 26) + (Q / 2)) / Q);
+
+// R^2 mod q, multiplying by which, using Montgomery multiplication, brings a value out of R^-1 scaled domain.
+inline constexpr int16_t R2_MOD_Q = static_cast<int16_t>((static_cast<uint64_t>(1) << 32) % Q);
+
+// Given a signed 32 -bit integer a | |a| < q * 2^15, this routine computes a * 2^-16 mod q, as a representative ∈ (-q, q).
+forceinline constexpr int16_t // NOLINT(misc-include-cleaner)
+montgomery_reduce(const int32_t a)
+{
+  const auto t = static_cast<int16_t>(static_cast<int16_t>(a) * QINV);
+  return static_cast<int16_t>((a - (static_cast<int32_t>(t) * Q16)) >> 16);
+}
+
+// Montgomery multiplication, computing a * b * 2^-16 mod q, as a representative ∈ (-q, q), given that |a * b| < q * 2^15.
+forceinline constexpr int16_t
+fqmul(const int16_t a, const int16_t b)
+{
+  return montgomery_reduce(static_cast<int32_t>(a) * static_cast<int32_t>(b));
+}
+
+// Barrett reduction of a signed 16 -bit integer, producing a representative ∈ [0, q] ( see bound proof in unreduced.hpp ).
+forceinline constexpr int16_t
+barrett_reduce(const int16_t a)
+{
+  const int32_t t = (static_cast<int32_t>(a) * BARRETT_V) >> 26;
+  return static_cast<int16_t>(a - (t * Q16));
+}
+
+// Given a signed 16 -bit integer a ∈ [-q, 2q), this routine computes its canonical representative ∈ [0, q), without branching.
+forceinline constexpr int16_t
+canonicalize(const int16_t a)
+{
+  const int32_t t0 = a + ((a >> 15) & Q16);
+  const int32_t t1 = t0 - Q16;
+  const int32_t t2 = t1 + ((t1 >> 15) & Q16);
+
+  return static_cast<int16_t>(t2);
+}
+
+// Given a canonical element of Z_q, returns its Montgomery form a * 2^16 mod q, as a centered representative ∈ (-q/2, q/2].
+constexpr int16_t
+to_mont(const zq_t a)
+{
+  constexpr auto R_MOD_Q = zq_t((1U << 16) % Q);
+  const uint32_t v = (a * R_MOD_Q).raw();
+
+  return static_cast<int16_t>(v > (Q / 2) ? static_cast<int32_t>(v) - static_cast<int32_t>(Q) : static_cast<int32_t>(v));
+}
+
+// Given a 16 -bit multiplicand b, returns b * q^-1 mod 2^16, which is precomputed for speeding up vectorized Montgomery
+// multiplication by b.
+constexpr int16_t
+mul_qinv(const int16_t b)
+{
+  return static_cast<int16_t>(static_cast<uint16_t>(static_cast<uint32_t>(static_cast<uint16_t>(b)) * static_cast<uint16_t>(QINV)));
+}
+
+// A constant multiplicand in Montgomery form, along with its precomputed product with q^-1.
+struct twiddle_t
+{
+  int16_t zeta = 0;
+  int16_t zeta_qinv = 0;
+};
+
+constexpr twiddle_t
+make_twiddle(const zq_t zeta)
+{
+  const int16_t mont = to_mont(zeta);
+  return { mont, mul_qinv(mont) };
+}
+
+}
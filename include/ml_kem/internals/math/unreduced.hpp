@@ -0,0 +1,117 @@
+#pragma once
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+
+// Compile-time bound tracking for lazily reduced, signed 16 -bit coefficients.
+//
+// A kernel written in terms of `unreduced_t` carries, in its types, the range of every intermediate value it computes. Any
+// operation whose result may not fit in 16 bits fails to compile, so a kernel which compiles is a proof that its reduction schedule
+// never overflows. This lets reductions be placed only where the bound analysis requires them, instead of after every operation.
+namespace ml_kem_field {
+
+inline constexpr int32_t INT16_LO = std::numeric_limits<int16_t>::min();
+inline constexpr int32_t INT16_HI = std::numeric_limits<int16_t>::max();
+
+// A signed 16 -bit representative of an element of Z_q, which is known, at compile-time, to be ∈ [lo, hi].
+template<int32_t lo, int32_t hi>
+  requires((INT16_LO <= lo) && (lo <= hi) && (hi <= INT16_HI))
+struct unreduced_t
+{
+  static constexpr int32_t LO = lo;
+  static constexpr int32_t HI = hi;
+
+  int16_t v = 0;
+};
+
+// Largest absolute value of any element of range [lo, hi].
+consteval int32_t
+max_abs(const int32_t lo, const int32_t hi)
+{
+  return std::max(-lo, hi);
+}
+
+// Smallest range covering both given ranges.
+template<typename r0_t, typename r1_t>
+using range_union_t = unreduced_t<std::min(r0_t::LO, r1_t::LO), std::max(r0_t::HI, r1_t::HI)>;
+
+// Coefficients, as produced by any routine computing a canonical representative.
+using canonical_t = unreduced_t<0, Q16 - 1>;
+
+// Coefficients ∈ (-q, q), as produced by Montgomery multiplication.
+using centered_t = unreduced_t<-(Q16 - 1), Q16 - 1>;
+
+// Coefficients, about which nothing is known, other than that they fit in 16 bits.
+using any_int16_t = unreduced_t<INT16_LO, INT16_HI>;
+
+template<int32_t lo0, int32_t hi0, int32_t lo1, int32_t hi1>
+forceinline constexpr unreduced_t<lo0 + lo1, hi0 + hi1> // NOLINT(misc-include-cleaner)
+operator+(const unreduced_t<lo0, hi0> a, const unreduced_t<lo1, hi1> b)
+{
+  return { static_cast<int16_t>(a.v + b.v) };
+}
+
+template<int32_t lo0, int32_t hi0, int32_t lo1, int32_t hi1>
+forceinline constexpr unreduced_t<lo0 - hi1, hi0 - lo1>
+operator-(const unreduced_t<lo0, hi0> a, const unreduced_t<lo1, hi1> b)
+{
+  return { static_cast<int16_t>(a.v - b.v) };
+}
+
+// Montgomery multiplication of two bounded values, computing a * b * 2^-16 mod q. Requires that |a * b| < q * 2^15.
+template<int32_t lo0, int32_t hi0, int32_t lo1, int32_t hi1>
+forceinline constexpr centered_t
+fqmul(const unreduced_t<lo0, hi0> a, const unreduced_t<lo1, hi1> b)
+  requires(static_cast<int64_t>(max_abs(lo0, hi0)) * max_abs(lo1, hi1) < static_cast<int64_t>(Q) << 15)
+{
+  return { fqmul(a.v, b.v) };
+}
+
+// Montgomery multiplication of a bounded value with a constant in centered Montgomery form, as produced by `to_mont`.
+template<int32_t lo, int32_t hi>
+forceinline constexpr centered_t
+fqmul(const unreduced_t<lo, hi> a, const int16_t b)
+{
+  return fqmul(a, unreduced_t<-static_cast<int32_t>(Q / 2), Q / 2>{ b });
+}
+
+// Barrett reduction of any signed 16 -bit integer, producing a representative ∈ [0, q].
+template<int32_t lo, int32_t hi>
+forceinline constexpr unreduced_t<0, Q16>
+barrett_reduce(const unreduced_t<lo, hi> a)
+{
+  return { barrett_reduce(a.v) };
+}
+
+// Given a representative ∈ [-q, 2q), computes the canonical one.
+template<int32_t lo, int32_t hi>
+forceinline constexpr canonical_t
+canonicalize(const unreduced_t<lo, hi> a)
+  requires((lo >= -static_cast<int32_t>(Q)) && (hi < 2 * static_cast<int32_t>(Q)))
+{
+  return { canonicalize(a.v) };
+}
+
+// Given any signed 16 -bit integer, computes its canonical representative ∈ [0, q).
+forceinline constexpr int16_t
+to_canonical(const int16_t a)
+{
+  return canonicalize(barrett_reduce(any_int16_t{ a })).v;
+}
+
+// Bound proof for `barrett_reduce`, checked exhaustively over all signed 16 -bit integers.
+static_assert(
+  []() -> bool {
+    for (int32_t a = INT16_LO; a <= INT16_HI; a++) {
+      const int16_t r = barrett_reduce(static_cast<int16_t>(a));
+      if ((r < 0) || (r > Q16) || ((a - r) % Q16 != 0)) {
+        return false;
+      }
+    }
+    return true;
+  }(),
+  "Barrett reduction must produce a representative ∈ [0, q]");
+
+}
@@ -14,14 +14,39 @@
 // Key Encapsulation Mechanism
 namespace ml_kem {
 
-// ML-KEM key generation algorithm, generating byte serialized public key and secret key, given 32 -bytes seed `d` and `z`.
+// Caller-supplied workspace for ML-KEM key generation, encapsulation and decapsulation, holding all of their large temporaries, s.t. the
+// per-call stack footprint stays small ( mostly hasher states and 64 -bytes seeds ), and a long-lived workspace, say owned by a thread,
+// stays hot in cache across calls. It holds
+//
+// - Public matrix A ( or a single row of it, when streamed, see `ML_KEM_STREAM_MATRIX` ) and decoded vector t, which are never zeroized.
+// - Re-encrypted cipher text, computed during decapsulation, which is zeroized before returning.
+// - Scratch space of K-PKE routines, whose secret regions are zeroized by the routines using them, see `k_pke::scratch_t`.
+//
+// None of the routines expect it to be initialized, so it can be reused across calls, without clearing it. But it must not be used by
+// more than one call at a time.
+template<size_t k, bool stream = ML_KEM_STREAM_MATRIX != 0>
+struct workspace_t
+{
+  alignas(64) std::array<int16_t, k_pke::get_matrix_buf_len(k, stream)> A_prime{};
+  alignas(64) std::array<int16_t, k * ml_kem_ntt::N> t_prime{};
+
+  // Large enough for cipher text of any parameter set, using this k, as du <= 11 and dv <= 5.
+  alignas(64) std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, 11, 5)> c_prime{};
+
+  k_pke::scratch_t<k> pke{};
+};
+
+// ML-KEM key generation algorithm, generating byte serialized public key and secret key, given 32 -bytes seed `d` and `z`, using
+// caller-supplied workspace for holding all large temporaries.
+//
 // See algorithm 16 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
-template<size_t k, size_t eta1>
+template<size_t k, size_t eta1, bool stream = ML_KEM_STREAM_MATRIX != 0>
 constexpr void
 keygen(std::span<const uint8_t, 32> d, // used in CPA-PKE
        std::span<const uint8_t, 32> z, // used in CCA-KEM
        std::span<uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey,
-       std::span<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey)
+       std::span<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey,
+       workspace_t<k, stream>& ws)
   requires(ml_kem_params::check_keygen_params(k, eta1))
 {
   constexpr size_t seckey_offset_kpke_skey = k * 12 * 32;
@@ -33,7 +58,7 @@ keygen(std::span<const uint8_t, 32> d, // used in CPA-PKE
   auto kpke_pkey_digest_in_seckey = seckey.template subspan<seckey_offset_kpke_pkey, seckey_offset_z - seckey_offset_kpke_pkey>();
   auto z_in_seckey = seckey.template subspan<seckey_offset_z, seckey.size() - seckey_offset_z>();
 
-  k_pke::keygen<k, eta1>(d, kpke_pkey_in_seckey, kpke_skey_in_seckey);
+  k_pke::keygen<k, eta1, stream>(d, kpke_pkey_in_seckey, kpke_skey_in_seckey, ws.A_prime, ws.t_prime, ws.pke);
   std::copy(kpke_pkey_in_seckey.begin(), kpke_pkey_in_seckey.end(), pubkey.begin());
   std::copy(z.begin(), z.end(), z_in_seckey.begin());
 
@@ -44,8 +69,98 @@ keygen(std::span<const uint8_t, 32> d, // used in CPA-PKE
   hasher.reset();
 }
 
+// ML-KEM key generation algorithm, generating byte serialized public key and secret key, given 32 -bytes seed `d` and `z`.
+// See algorithm 16 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, bool stream = ML_KEM_STREAM_MATRIX != 0>
+constexpr void
+keygen(std::span<const uint8_t, 32> d, // used in CPA-PKE
+       std::span<const uint8_t, 32> z, // used in CCA-KEM
+       std::span<uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey,
+       std::span<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey)
+  requires(ml_kem_params::check_keygen_params(k, eta1))
+{
+  ml_kem_utils::with_temporary<workspace_t<k, stream>>([&](auto& ws) { keygen<k, eta1, stream>(d, z, pubkey, seckey, ws); });
+}
+
+// ML-KEM public key, validated and expanded once, s.t. it can be used for encapsulating many times, without repeating any of the work
+// which depends on the public key only. It holds
+//
+// - H(ek), the SHA3-256 digest of the byte serialized public key, used in line 1 of algorithm 17.
+// - NTT domain vector t, decoded from the public key, see line 2 of algorithm 14.
+// - Transpose of matrix A, expanded from seed ρ, see line 3-8 of algorithm 14.
+//
+// Only a prepared public key, for which `prepare_pubkey` returned true, must be used for encapsulation.
+template<size_t k>
+struct prepared_pubkey_t
+{
+  std::array<uint8_t, sha3_256::DIGEST_LEN> h{};
+  std::array<int16_t, k * ml_kem_ntt::N> t_prime{};
+  std::array<int16_t, k * k * ml_kem_ntt::N> A_prime{};
+};
+
+// Given ML-KEM public key, this routine validates it, performing the modulus check, as described in point (2) of section 7.2 of ML-KEM
+// specification, and prepares it for repeated encapsulation. If the public key is malformed, it returns false.
+template<size_t k>
+[[nodiscard("Use result, it might fail because of malformed input public key")]] constexpr bool
+prepare_pubkey(std::span<const uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey, prepared_pubkey_t<k>& prepared)
+  requires(ml_kem_params::check_k(k))
+{
+  if (!k_pke::prepare_pubkey<k>(pubkey, prepared.t_prime, prepared.A_prime)) {
+    // Got an invalid public key
+    return false;
+  }
+
+  sha3_256::sha3_256_t h256{};
+  h256.absorb(pubkey);
+  h256.finalize();
+  h256.digest(prepared.h);
+
+  return true;
+}
+
+// Given a prepared ML-KEM public key and 32 -bytes seed ( used for deriving 32 -bytes message & 32 -bytes random coin ), this routine
+// computes ML-KEM cipher text and a 32 -bytes shared secret, same as `encapsulate` below does, given the byte serialized public key.
+// As the public key has already been validated, this can't fail.
+//
+// See algorithm 17 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+constexpr void
+encapsulate(std::span<const uint8_t, 32> m,
+            const prepared_pubkey_t<k>& pubkey,
+            std::span<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+            std::span<uint8_t, 32> shared_secret)
+  requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+{
+  std::array<uint8_t, m.size() + sha3_256::DIGEST_LEN> g_in{};
+  std::array<uint8_t, sha3_512::DIGEST_LEN> g_out{};
+
+  auto g_in_span = std::span(g_in);
+  auto g_in_span0 = g_in_span.template first<m.size()>();
+  auto g_in_span1 = g_in_span.template last<sha3_256::DIGEST_LEN>();
+
+  auto g_out_span = std::span(g_out);
+  auto g_out_span0 = g_out_span.template first<shared_secret.size()>();
+  auto g_out_span1 = g_out_span.template last<g_out_span.size() - g_out_span0.size()>();
+
+  std::copy(m.begin(), m.end(), g_in_span0.begin());
+  std::copy(pubkey.h.begin(), pubkey.h.end(), g_in_span1.begin());
+
+  sha3_512::sha3_512_t h512{};
+  h512.absorb(g_in_span);
+  h512.finalize();
+  h512.digest(g_out_span);
+
+  ml_kem_utils::with_temporary<k_pke::scratch_t<k>>(
+    [&](auto& scratch) { k_pke::encrypt_prepared<k, eta1, eta2, du, dv>(pubkey.t_prime, pubkey.A_prime, m, g_out_span1, cipher, scratch); });
+  std::copy(g_out_span0.begin(), g_out_span0.end(), shared_secret.begin());
+
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+}
+
 // Given ML-KEM public key and 32 -bytes seed ( used for deriving 32 -bytes message & 32 -bytes random coin ), this routine computes
-// ML-KEM cipher text which can be shared with recipient party ( owning corresponding secret key ) over insecure channel.
+// ML-KEM cipher text which can be shared with recipient party ( owning corresponding secret key ) over insecure channel, using
+// caller-supplied workspace for holding all large temporaries.
 //
 // It also computes a fixed length 32 -bytes shared secret, which can be used for fast symmetric key encryption between these
 // two participating entities. Alternatively they might choose to derive longer keys from this shared secret. Other side of
@@ -54,12 +169,13 @@ keygen(std::span<const uint8_t, 32> d, // used in CPA-PKE
 // If invalid ML-KEM public key is input, this function execution will fail, returning false.
 //
 // See algorithm 17 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
-template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, bool stream = ML_KEM_STREAM_MATRIX != 0>
 [[nodiscard("Use result, it might fail because of malformed input public key")]] constexpr bool
 encapsulate(std::span<const uint8_t, 32> m,
             std::span<const uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey,
             std::span<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
-            std::span<uint8_t, 32> shared_secret)
+            std::span<uint8_t, 32> shared_secret,
+            workspace_t<k, stream>& ws)
   requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
 {
   std::array<uint8_t, m.size() + sha3_256::DIGEST_LEN> g_in{};
@@ -85,33 +201,48 @@ encapsulate(std::span<const uint8_t, 32> m,
   h512.finalize();
   h512.digest(g_out_span);
 
-  const auto has_mod_check_passed = k_pke::encrypt<k, eta1, eta2, du, dv>(pubkey, m, g_out_span1, cipher);
-  if (!has_mod_check_passed) {
-    // Got an invalid public key
-    ml_kem_utils::secure_zeroize(g_in);
-    ml_kem_utils::secure_zeroize(g_out);
-    return has_mod_check_passed;
+  const auto has_mod_check_passed = k_pke::encrypt<k, eta1, eta2, du, dv, stream>(pubkey, m, g_out_span1, cipher, ws.A_prime, ws.t_prime, ws.pke);
+  if (has_mod_check_passed) {
+    std::copy(g_out_span0.begin(), g_out_span0.end(), shared_secret.begin());
   }
 
-  std::copy(g_out_span0.begin(), g_out_span0.end(), shared_secret.begin());
-
   ml_kem_utils::secure_zeroize(g_in);
   ml_kem_utils::secure_zeroize(g_out);
-  return true;
+  return has_mod_check_passed;
+}
+
+// Given ML-KEM public key and 32 -bytes seed ( used for deriving 32 -bytes message & 32 -bytes random coin ), this routine computes
+// ML-KEM cipher text and a 32 -bytes shared secret, same as `encapsulate` above does, using a workspace on stack.
+//
+// If invalid ML-KEM public key is input, this function execution will fail, returning false.
+//
+// See algorithm 17 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, bool stream = ML_KEM_STREAM_MATRIX != 0>
+[[nodiscard("Use result, it might fail because of malformed input public key")]] constexpr bool
+encapsulate(std::span<const uint8_t, 32> m,
+            std::span<const uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey,
+            std::span<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+            std::span<uint8_t, 32> shared_secret)
+  requires(ml_kem_params::check_encap_params(k, eta1, eta2, du, dv))
+{
+  return ml_kem_utils::with_temporary<workspace_t<k, stream>>(
+    [&](auto& ws) { return encapsulate<k, eta1, eta2, du, dv, stream>(m, pubkey, cipher, shared_secret, ws); });
 }
 
 // Given ML-KEM secret key and cipher text, this routine recovers 32 -bytes plain text which was encrypted by sender,
 // using ML-KEM public key, associated with this secret key.
 //
 // Recovered 32 -bytes plain text is used for deriving a 32 -bytes shared secret key, which can now be
-// used for encrypting communication between two participating parties, using fast symmetric key algorithms.
+// used for encrypting communication between two participating parties, using fast symmetric key algorithms. All large temporaries
+// are held in caller-supplied workspace.
 //
 // See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
-template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, bool stream = ML_KEM_STREAM_MATRIX != 0>
 constexpr void
 decapsulate(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey,
             std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
-            std::span<uint8_t, 32> shared_secret)
+            std::span<uint8_t, 32> shared_secret,
+            workspace_t<k, stream>& ws)
   requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
 {
   constexpr size_t pke_sk_len = (k * 12 * 32);
@@ -130,7 +261,7 @@ decapsulate(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> se
   std::array<uint8_t, 32 + h.size()> g_in{};
   std::array<uint8_t, shared_secret.size() + 32> g_out{};
   std::array<uint8_t, shared_secret.size()> j_out{};
-  std::array<uint8_t, cipher.size()> c_prime{};
+  auto c_prime = std::span(ws.c_prime).template first<ctlen>();
 
   auto g_in_span = std::span(g_in);
   auto g_in_span0 = g_in_span.template first<32>();
@@ -140,7 +271,7 @@ decapsulate(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> se
   auto g_out_span0 = g_out_span.template first<shared_secret.size()>();
   auto g_out_span1 = g_out_span.template last<32>();
 
-  k_pke::decrypt<k, du, dv>(pke_sk, cipher, g_in_span0);
+  k_pke::decrypt<k, du, dv>(pke_sk, cipher, g_in_span0, ws.pke);
   std::copy(h.begin(), h.end(), g_in_span1.begin());
 
   sha3_512::sha3_512_t h512{};
@@ -155,17 +286,193 @@ decapsulate(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> se
   xof256.squeeze(j_out);
 
   // Explicitly ignore return value, because public key, held as part of secret key is *assumed* to be valid.
-  (void)k_pke::encrypt<k, eta1, eta2, du, dv>(pubkey, g_in_span0, g_out_span1, c_prime);
+  (void)k_pke::encrypt<k, eta1, eta2, du, dv, stream>(pubkey, g_in_span0, g_out_span1, c_prime, ws.A_prime, ws.t_prime, ws.pke);
 
   // line 9-12 of algorithm 17, in constant-time
   using kdf_t = std::span<const uint8_t, shared_secret.size()>;
   const uint32_t cond = ml_kem_utils::ct_memcmp(cipher, std::span<const uint8_t, ctlen>(c_prime));
   ml_kem_utils::ct_cond_memcpy(cond, shared_secret, kdf_t(g_out_span0), kdf_t(j_out));
 
+  ml_kem_utils::secure_zeroize(g_in);
+  ml_kem_utils::secure_zeroize(g_out);
+  ml_kem_utils::secure_zeroize(j_out);
+  ml_kem_utils::secure_zeroize(ws.c_prime);
+}
+
+// Given ML-KEM secret key and cipher text, this routine computes 32 -bytes shared secret, same as `decapsulate` above does, using a
+// workspace on stack.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv, bool stream = ML_KEM_STREAM_MATRIX != 0>
+constexpr void
+decapsulate(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey,
+            std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+            std::span<uint8_t, 32> shared_secret)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  ml_kem_utils::with_temporary<workspace_t<k, stream>>([&](auto& ws) { decapsulate<k, eta1, eta2, du, dv, stream>(seckey, cipher, shared_secret, ws); });
+}
+
+// ML-KEM secret key, validated and decoded once, s.t. it can be used for decapsulating many times, without repeating any of the work
+// which depends on the secret key only. It holds
+//
+// - NTT domain vector s, decoded from the secret key, see line 5 of algorithm 15, along with its multiplication cache.
+// - Prepared public key, embedded in the secret key, used for re-encryption, see line 8 of algorithm 18.
+// - Implicit rejection value z.
+//
+// Only a prepared secret key, for which `prepare_seckey` returned true, must be used for decapsulation. As it holds secret material,
+// vector s, its multiplication cache and z are zeroized, when it goes out of scope.
+template<size_t k>
+struct prepared_seckey_t
+{
+  std::array<int16_t, k * ml_kem_ntt::N> s_prime{};
+  std::array<int16_t, k * ml_kem_ntt::N / 2> s_cache{};
+  prepared_pubkey_t<k> pubkey{};
+  std::array<uint8_t, 32> z{};
+
+  constexpr ~prepared_seckey_t()
+  {
+    ml_kem_utils::secure_zeroize(s_prime);
+    ml_kem_utils::secure_zeroize(s_cache);
+    ml_kem_utils::secure_zeroize(z);
+  }
+};
+
+// Given ML-KEM secret key, this routine validates it, performing the hash check, as described in point (3) of section 7.3 of ML-KEM
+// specification, and prepares it for repeated decapsulation. If the hash check fails, it returns false. Going beyond section 7.3, it also
+// returns false, if embedded public key doesn't pass the modulus check of section 7.2, as it's prepared for re-encryption the same way
+// `prepare_pubkey` prepares a public key for encapsulation.
+template<size_t k>
+[[nodiscard("Use result, it might fail because of malformed input secret key")]] constexpr bool
+prepare_seckey(std::span<const uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey, prepared_seckey_t<k>& prepared)
+  requires(ml_kem_params::check_k(k))
+{
+  constexpr size_t pke_sk_len = (k * 12 * 32);
+  constexpr size_t pke_pk_len = (k * 12 * 32) + 32;
+
+  constexpr size_t skoff0 = pke_sk_len;
+  constexpr size_t skoff1 = skoff0 + pke_pk_len;
+  constexpr size_t skoff2 = skoff1 + 32;
+
+  auto pke_sk = seckey.template subspan<0, skoff0>();
+  auto pubkey = seckey.template subspan<skoff0, skoff1 - skoff0>();
+  auto h = seckey.template subspan<skoff1, skoff2 - skoff1>();
+  auto z = seckey.template subspan<skoff2, seckey.size() - skoff2>();
+
+  if (!prepare_pubkey<k>(pubkey, prepared.pubkey)) {
+    // Got an invalid public key, embedded in secret key
+    return false;
+  }
+
+  using digest_t = std::span<const uint8_t, sha3_256::DIGEST_LEN>;
+  const uint32_t is_hash_ok = ml_kem_utils::ct_memcmp(digest_t(prepared.pubkey.h), h);
+  if (is_hash_ok == 0U) {
+    // Hash of public key doesn't match the one held in secret key
+    return false;
+  }
+
+  ml_kem_utils::poly_vec_decode<k, 12>(pke_sk, prepared.s_prime);
+  ml_kem_utils::poly_vec_mulcache<k>(prepared.s_prime, prepared.s_cache);
+  std::copy(z.begin(), z.end(), prepared.z.begin());
+
+  return true;
+}
+
+// Given a prepared ML-KEM secret key and cipher text, already decoded by `k_pke::decode_cipher_text`, with vector u in NTT domain and
+// polynomial v placed in `scratch.v`, this routine computes 32 -bytes shared secret, same as `decapsulate` does, using supplied K-PKE
+// scratch space and buffer for holding re-encrypted cipher text, which is zeroized before returning. Vector u is only read before
+// re-encryption, so it may live in `scratch.u`.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+constexpr void
+decapsulate_decoded(const prepared_seckey_t<k>& seckey,
+                    std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+                    std::span<const int16_t, k * ml_kem_ntt::N> u_prime,
+                    std::span<uint8_t, 32> shared_secret,
+                    k_pke::scratch_t<k>& scratch,
+                    std::span<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> c_prime)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  std::array<uint8_t, 32 + sha3_256::DIGEST_LEN> g_in{};
+  std::array<uint8_t, shared_secret.size() + 32> g_out{};
+  std::array<uint8_t, shared_secret.size()> j_out{};
+
+  auto g_in_span = std::span(g_in);
+  auto g_in_span0 = g_in_span.template first<32>();
+  auto g_in_span1 = g_in_span.template last<sha3_256::DIGEST_LEN>();
+
+  auto g_out_span = std::span(g_out);
+  auto g_out_span0 = g_out_span.template first<shared_secret.size()>();
+  auto g_out_span1 = g_out_span.template last<32>();
+
+  k_pke::decrypt_decoded<k>(seckey.s_prime, seckey.s_cache, u_prime, g_in_span0, scratch);
+  std::copy(seckey.pubkey.h.begin(), seckey.pubkey.h.end(), g_in_span1.begin());
+
+  sha3_512::sha3_512_t h512{};
+  h512.absorb(g_in_span);
+  h512.finalize();
+  h512.digest(g_out_span);
+
+  shake256::shake256_t xof256{};
+  xof256.absorb(seckey.z);
+  xof256.absorb(cipher);
+  xof256.finalize();
+  xof256.squeeze(j_out);
+
+  k_pke::encrypt_prepared<k, eta1, eta2, du, dv>(seckey.pubkey.t_prime, seckey.pubkey.A_prime, g_in_span0, g_out_span1, c_prime, scratch);
+
+  // line 9-11 of algorithm 18, in constant-time
+  using kdf_t = std::span<const uint8_t, shared_secret.size()>;
+  const uint32_t cond = ml_kem_utils::ct_memcmp(cipher, std::span<const uint8_t, c_prime.size()>(c_prime));
+  ml_kem_utils::ct_cond_memcpy(cond, shared_secret, kdf_t(g_out_span0), kdf_t(j_out));
+
   ml_kem_utils::secure_zeroize(g_in);
   ml_kem_utils::secure_zeroize(g_out);
   ml_kem_utils::secure_zeroize(j_out);
   ml_kem_utils::secure_zeroize(c_prime);
 }
 
+// Given a prepared ML-KEM secret key and cipher text, this routine computes 32 -bytes shared secret, same as `decapsulate` does, given
+// the byte serialized secret key, using supplied K-PKE scratch space and buffer for holding re-encrypted cipher text, which is zeroized
+// before returning.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+constexpr void
+decapsulate_with(const prepared_seckey_t<k>& seckey,
+                 std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+                 std::span<uint8_t, 32> shared_secret,
+                 k_pke::scratch_t<k>& scratch,
+                 std::span<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> c_prime)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  k_pke::decode_cipher_text<k, du, dv>(cipher, scratch.u, scratch.v);
+  decapsulate_decoded<k, eta1, eta2, du, dv>(seckey, cipher, scratch.u, shared_secret, scratch, c_prime);
+}
+
+// Given a prepared ML-KEM secret key and cipher text, this routine computes 32 -bytes shared secret, same as `decapsulate` above does,
+// given the byte serialized secret key, while skipping all work that depends on the secret key only.
+//
+// See algorithm 18 defined in ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+constexpr void
+decapsulate(const prepared_seckey_t<k>& seckey,
+            std::span<const uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher,
+            std::span<uint8_t, 32> shared_secret)
+  requires(ml_kem_params::check_decap_params(k, eta1, eta2, du, dv))
+{
+  constexpr size_t ctlen = 32 * (k * du + dv);
+
+  // Scratch space of K-PKE routines, along with re-encrypted cipher text.
+  struct temporaries_t
+  {
+    k_pke::scratch_t<k> pke{};
+    std::array<uint8_t, ctlen> c_prime{};
+  };
+
+  ml_kem_utils::with_temporary<temporaries_t>(
+    [&](temporaries_t& tmp) { decapsulate_with<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret, tmp.pke, tmp.c_prime); });
+}
+
 }
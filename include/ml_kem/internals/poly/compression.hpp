@@ -1,11 +1,16 @@
 #pragma once
+#include "ml_kem/internals/arch/avx2/compression.hpp"
 #include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/unreduced.hpp"
 #include "ml_kem/internals/poly/ntt.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
 #include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
 #include "ml_kem/internals/utility/params.hpp"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <type_traits>
 
 namespace ml_kem_utils {
 
@@ -70,4 +75,120 @@ poly_decompress(std::span<ml_kem_field::zq_t, ml_kem_ntt::N> poly)
   }
 }
 
+// Same as `poly_compress` above, but for a polynomial with signed 16 -bit coefficients, which may be lazily reduced.
+template<size_t d>
+constexpr void
+poly_compress(std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(ml_kem_params::check_d(d))
+{
+  for (auto& coeff : poly) {
+    coeff = static_cast<int16_t>(compress<d>(ml_kem_field::zq_t(static_cast<uint16_t>(ml_kem_field::to_canonical(coeff)))).raw());
+  }
+}
+
+// Same as `poly_decompress` above, but for a polynomial with signed 16 -bit coefficients, each ∈ [0, 2^d).
+template<size_t d>
+constexpr void
+poly_decompress(std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(ml_kem_params::check_d(d))
+{
+  for (auto& coeff : poly) {
+    coeff = static_cast<int16_t>(decompress<d>(ml_kem_field::zq_t(static_cast<uint16_t>(coeff))).raw());
+  }
+}
+
+// Decompressed value of each of 2^d possible d -bit ciphertext coefficients, used for d ∈ {4, 5}, where the table fits in one or two cache
+// lines. Table lookup is indexed by public ciphertext bytes only, hence it doesn't leak anything secret.
+template<size_t d>
+inline constexpr auto DECOMPRESS_LUT = []() {
+  std::array<int16_t, 1U << d> res{};
+
+  for (size_t i = 0; i < res.size(); i++) {
+    res[i] = static_cast<int16_t>(decompress<d>(ml_kem_field::zq_t(static_cast<uint16_t>(i))).raw());
+  }
+
+  return res;
+}();
+
+// Given a degree-255 polynomial with signed 16 -bit coefficients, which may be lazily reduced, this routine compresses each coefficient to
+// d bits and serializes them to a byte array of length 32 * d -bytes, in a single pass, producing same bytes as `poly_compress<d>`,
+// followed by `encode<d>`, do. Compressed coefficients are streamed LSB-first through a small bit accumulator, never materializing
+// the compressed polynomial. When executing CPU supports AVX2, a vectorized kernel, producing same bytes, is used.
+//
+// See algorithm 14 and 15 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203, where this operation shows up.
+template<size_t d>
+constexpr void
+compress_encode(std::span<const int16_t, ml_kem_ntt::N> poly, std::span<uint8_t, 32 * d> arr)
+  requires(ml_kem_params::check_d(d))
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    avx2::compress_encode<d>(poly, arr);
+    return;
+  }
+#endif
+
+  uint32_t acc = 0;
+  size_t acc_bits = 0;
+  size_t boff = 0;
+
+  for (const auto coeff : poly) {
+    const auto c = compress<d>(ml_kem_field::zq_t(static_cast<uint16_t>(ml_kem_field::to_canonical(coeff))));
+
+    acc |= static_cast<uint32_t>(c.raw()) << acc_bits;
+    acc_bits += d;
+
+    while (acc_bits >= 8) {
+      arr[boff++] = static_cast<uint8_t>(acc);
+      acc >>= 8;
+      acc_bits -= 8;
+    }
+  }
+}
+
+// Given a byte array of length 32 * d -bytes, this routine deserializes it to 256 coefficients of d bits each and decompresses them, in a
+// single pass, producing same coefficients as `decode<d>`, followed by `poly_decompress<d>`, do. For d ∈ {4, 5}, decompression is a
+// lookup in a small table. For d = 1, which is used for the secret message, decompression is computed using masking, without indexing
+// memory using secret. When executing CPU supports AVX2, a vectorized kernel, producing same coefficients, is used.
+//
+// See algorithm 14 and 15 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203, where this operation shows up.
+template<size_t d>
+constexpr void
+decode_decompress(std::span<const uint8_t, 32 * d> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(ml_kem_params::check_d(d))
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    avx2::decode_decompress<d>(arr, poly);
+    return;
+  }
+#endif
+
+  constexpr uint32_t mask = (1U << d) - 1U;
+  constexpr auto half_q = static_cast<uint16_t>((ml_kem_field::Q + 1) / 2);
+
+  uint32_t acc = 0;
+  size_t acc_bits = 0;
+  size_t boff = 0;
+
+  for (auto& coeff : poly) {
+    while (acc_bits < d) {
+      acc |= static_cast<uint32_t>(arr[boff++]) << acc_bits;
+      acc_bits += 8;
+    }
+
+    const uint32_t c = acc & mask;
+    acc >>= d;
+    acc_bits -= d;
+
+    if constexpr (d == 1) {
+      coeff = static_cast<int16_t>(static_cast<uint16_t>(-c) & half_q);
+    } else if constexpr ((d == 4) || (d == 5)) {
+      coeff = DECOMPRESS_LUT<d>[c];
+    } else {
+      coeff = static_cast<int16_t>(decompress<d>(ml_kem_field::zq_t(static_cast<uint16_t>(c))).raw());
+    }
+  }
+}
+
 }
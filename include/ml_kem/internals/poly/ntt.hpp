@@ -1,76 +1,27 @@
 #pragma once
+#include "ml_kem/internals/arch/avx2/ntt.hpp"
+#include "ml_kem/internals/arch/avx512/ntt.hpp"
 #include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/math/unreduced.hpp"
+#include "ml_kem/internals/poly/ntt_consts.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
 #include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
-#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <span>
+#include <type_traits>
 
-namespace ml_kem_ntt {
-
-inline constexpr size_t LOG2N = 8;
-inline constexpr size_t N = 1 << LOG2N;
-
-// First primitive 256 -th root of unity modulo q | q = 3329
-//
-// Meaning, 17 ** 256 == 1 mod q
-inline constexpr auto ZETA = ml_kem_field::zq_t(17);
-static_assert((ZETA ^ N) == ml_kem_field::zq_t::one(), "ZETA must be 256th root of unity modulo Q");
-
-// Multiplicative inverse of N/ 2 over Z_q | q = 3329 and N = 256
-//
-// Meaning (N/ 2) * INV_N = 1 mod q
-inline constexpr auto INV_N = ml_kem_field::zq_t(N / 2).inv();
-
-// Given a 64 -bit unsigned integer, this routine extracts specified many contiguous bits from ( least significant bits ) LSB side
-// and reverses their bit order, returning bit reversed `mbw` -bit wide number.
-//
-// See https://github.com/itzmeanjan/falcon/blob/45b0593/include/ntt.hpp#L30-L38 for source of inspiration.
-template<size_t mbw>
-forceinline constexpr size_t // NOLINT(misc-include-cleaner)
-bit_rev(const size_t v)
-{
-  size_t v_rev = 0UL;
-
-  for (size_t i = 0; i < mbw; i++) {
-    const size_t bit = (v >> i) & 0b1;
-    v_rev ^= bit << (mbw - 1UL - i);
-  }
-
-  return v_rev;
-}
-
-// Compile-time computed constants ( powers of ζ ), used for polynomial evaluation i.e. computation of NTT form.
-inline constexpr std::array<ml_kem_field::zq_t, N / 2> NTT_ZETA_EXP = []() -> auto {
-  std::array<ml_kem_field::zq_t, N / 2> res{};
-
-  for (size_t i = 0; i < res.size(); i++) {
-    res[i] = ZETA ^ bit_rev<LOG2N - 1>(i);
-  }
-
-  return res;
-}();
-
-// Compile-time computed constants ( negated powers of ζ ), used for polynomial interpolation i.e. computation of iNTT form.
-inline constexpr std::array<ml_kem_field::zq_t, N / 2> INTT_ZETA_EXP = []() -> auto {
-  std::array<ml_kem_field::zq_t, N / 2> res{};
-
-  for (size_t i = 0; i < res.size(); i++) {
-    res[i] = -NTT_ZETA_EXP[i];
-  }
-
-  return res;
-}();
-
-// Compile-time computed constants ( powers of ζ ), used when multiplying two degree-255 polynomials in NTT domain.
-inline constexpr std::array<ml_kem_field::zq_t, N / 2> POLY_MUL_ZETA_EXP = []() -> auto {
-  std::array<ml_kem_field::zq_t, N / 2> res{};
-
-  for (size_t i = 0; i < res.size(); i++) {
-    res[i] = ZETA ^ ((bit_rev<LOG2N - 1>(i) << 1) ^ 1);
-  }
+// Define `ML_KEM_KARATSUBA_BASEMUL` as 1, for computing base case multiplications using Karatsuba's trick, in the portable
+// multiply-accumulate kernel ( see `ml_kem_ntt::scalar::polymul_acc` ). It trades a multiplication for three additions, which pays
+// off only on targets with slow multipliers. Vectorized kernels are not affected.
+#ifndef ML_KEM_KARATSUBA_BASEMUL
+#define ML_KEM_KARATSUBA_BASEMUL 0
+#endif
 
-  return res;
-}();
+// Portable implementation of NTT, iNTT and polynomial multiplication in NTT domain, over `zq_t` coefficients. It is always used
+// during compile-time evaluation and serves as the reference, which all vectorized implementations must match bit-by-bit.
+namespace ml_kem_ntt::scalar {
 
 // Given a polynomial f with 256 coefficients over F_q | q = 3329, this routine computes number theoretic transform
 // using Cooley-Tukey algorithm, producing polynomial f' s.t. its coefficients are placed in bit-reversed order.
@@ -79,7 +30,7 @@ inline constexpr std::array<ml_kem_field::zq_t, N / 2> POLY_MUL_ZETA_EXP = []()
 //
 // Implementation inspired from https://github.com/itzmeanjan/falcon/blob/45b0593/include/ntt.hpp#L69-L144.
 // See algorithm 9 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
-forceinline constexpr void
+forceinline constexpr void // NOLINT(misc-include-cleaner)
 ntt(std::span<ml_kem_field::zq_t, N> poly)
 {
   for (size_t lvl = LOG2N - 1; lvl >= 1; lvl--) {
@@ -196,3 +147,448 @@ polymul(std::span<const ml_kem_field::zq_t, N> f, std::span<const ml_kem_field::
 }
 
 }
+
+// Portable implementation of NTT, iNTT and polynomial multiplication in NTT domain, over signed 16 -bit coefficients, using
+// Montgomery arithmetic ( see `ml_kem_field::fqmul` ). Used by K-PKE, whenever no vectorized implementation is available. These
+// follow the same reduction strategy as vectorized kernels do, so that all of them produce identical output.
+//
+// Coefficients are lazily reduced. Each layer is written in terms of `ml_kem_field::unreduced_t`, so that the range of coefficients
+// after every layer is tracked at compile-time and a reduction schedule which may overflow 16 -bit fails to compile.
+namespace ml_kem_ntt::scalar {
+
+using ml_kem_field::unreduced_t;
+
+// Given a polynomial, whose coefficients are ∈ [lo, hi], this routine applies one layer of Cooley-Tukey butterflies, with
+// len = 2^lvl, returning ( a tag of ) the range of output coefficients.
+template<size_t lvl, int32_t lo, int32_t hi>
+forceinline constexpr auto
+ntt_layer(std::span<int16_t, N> poly, const unreduced_t<lo, hi>)
+{
+  using in_t = unreduced_t<lo, hi>;
+  using out_t = decltype(in_t{} + ml_kem_field::fqmul(in_t{}, int16_t{}));
+  static_assert(std::is_same_v<out_t, decltype(in_t{} - ml_kem_field::fqmul(in_t{}, int16_t{}))>);
+
+  constexpr size_t len = static_cast<size_t>(1) << lvl;
+  constexpr size_t lenx2 = len << 1;
+  constexpr size_t k_beg = N >> (lvl + 1);
+
+  for (size_t start = 0; start < poly.size(); start += lenx2) {
+    const int16_t zeta = NTT_TWIDDLES[k_beg + (start >> (lvl + 1))].zeta;
+
+    for (size_t i = start; i < start + len; i++) {
+      const in_t a{ poly[i] };
+      const auto t = ml_kem_field::fqmul(in_t{ poly[i + len] }, zeta);
+
+      poly[i + len] = (a - t).v;
+      poly[i] = (a + t).v;
+    }
+  }
+
+  return out_t{};
+}
+
+// Given a polynomial, whose coefficients are ∈ [lo, hi], this routine applies one layer of Gentleman-Sande butterflies, with
+// len = 2^lvl, returning ( a tag of ) the range of output coefficients. Sums are Barrett reduced, only if `reduce` is set.
+template<size_t lvl, bool reduce, int32_t lo, int32_t hi>
+forceinline constexpr auto
+intt_layer(std::span<int16_t, N> poly, const unreduced_t<lo, hi>)
+{
+  using in_t = unreduced_t<lo, hi>;
+  using sum_t = decltype(in_t{} + in_t{});
+  using diff_t = decltype(ml_kem_field::fqmul(in_t{} - in_t{}, int16_t{}));
+  using red_t = std::conditional_t<reduce, decltype(ml_kem_field::barrett_reduce(sum_t{})), sum_t>;
+  using out_t = ml_kem_field::range_union_t<red_t, diff_t>;
+
+  constexpr size_t len = static_cast<size_t>(1) << lvl;
+  constexpr size_t lenx2 = len << 1;
+  constexpr size_t k_beg = (N >> lvl) - 1;
+
+  for (size_t start = 0; start < poly.size(); start += lenx2) {
+    const int16_t neg_zeta = INTT_TWIDDLES[k_beg - (start >> (lvl + 1))].zeta;
+
+    for (size_t i = start; i < start + len; i++) {
+      const in_t a{ poly[i] };
+      const in_t b{ poly[i + len] };
+
+      const auto sum = a + b;
+      if constexpr (reduce) {
+        poly[i] = ml_kem_field::barrett_reduce(sum).v;
+      } else {
+        poly[i] = sum.v;
+      }
+      poly[i + len] = ml_kem_field::fqmul(a - b, neg_zeta).v;
+    }
+  }
+
+  return out_t{};
+}
+
+// Given a polynomial f with 256 coefficients ∈ (-q, q), this routine computes its number theoretic transform in-place, using
+// Cooley-Tukey algorithm. Output coefficients are ∈ [0, q), placed in bit-reversed order.
+//
+// Absolute value of coefficients grows by less than q, after each layer, so no reduction is required until the end.
+constexpr void
+ntt(std::span<int16_t, N> poly)
+{
+  const auto r7 = ntt_layer<7>(poly, ml_kem_field::centered_t{});
+  const auto r6 = ntt_layer<6>(poly, r7);
+  const auto r5 = ntt_layer<5>(poly, r6);
+  const auto r4 = ntt_layer<4>(poly, r5);
+  const auto r3 = ntt_layer<3>(poly, r4);
+  const auto r2 = ntt_layer<2>(poly, r3);
+  const auto r1 = ntt_layer<1>(poly, r2);
+
+  using out_t = std::remove_cv_t<decltype(r1)>;
+  static_assert(out_t::HI == 8 * (ml_kem_field::Q16 - 1), "Each coefficient must be ∈ (-8q, 8q), after seven layers");
+
+  for (auto& coeff : poly) {
+    coeff = ml_kem_field::canonicalize(ml_kem_field::barrett_reduce(out_t{ coeff })).v;
+  }
+}
+
+// Given a polynomial, whose coefficients are ∈ [lo, hi], this routine applies the last layer of Gentleman-Sande butterflies, with
+// len = 128, whose twiddle factor is already scaled by N^-1, while scaling sums explicitly. Output coefficients are ∈ [0, q).
+template<int32_t lo, int32_t hi>
+forceinline constexpr void
+intt_last_layer(std::span<int16_t, N> poly, const unreduced_t<lo, hi>)
+{
+  using in_t = unreduced_t<lo, hi>;
+  constexpr size_t len = N / 2;
+
+  for (size_t i = 0; i < len; i++) {
+    const in_t a{ poly[i] };
+    const in_t b{ poly[i + len] };
+
+    poly[i] = ml_kem_field::canonicalize(ml_kem_field::fqmul(a + b, INV_N_TWIDDLE.zeta)).v;
+    poly[i + len] = ml_kem_field::canonicalize(ml_kem_field::fqmul(a - b, INTT_LAST_TWIDDLE.zeta)).v;
+  }
+}
+
+// Given a polynomial f with 256 coefficients ∈ (-q, q), placed in bit-reversed order, this routine computes its inverse number
+// theoretic transform in-place, using Gentleman-Sande algorithm. Output coefficients are ∈ [0, q), placed in standard order.
+//
+// Absolute value of coefficients at most doubles after each layer, so they are reduced after layers with len = 8 and len = 32.
+// Scaling by N^-1 is folded into the last layer. Vectorized kernels follow the very same schedule, which is proven not to overflow,
+// by the bounds tracked below.
+constexpr void
+intt(std::span<int16_t, N> poly)
+{
+  const auto r1 = intt_layer<1, false>(poly, ml_kem_field::centered_t{});
+  const auto r2 = intt_layer<2, false>(poly, r1);
+  const auto r3 = intt_layer<3, true>(poly, r2);
+  const auto r4 = intt_layer<4, false>(poly, r3);
+  const auto r5 = intt_layer<5, true>(poly, r4);
+  const auto r6 = intt_layer<6, false>(poly, r5);
+
+  using r6_t = std::remove_cv_t<decltype(r6)>;
+  static_assert(std::remove_cv_t<decltype(r2)>::HI == 4 * (ml_kem_field::Q16 - 1), "Reduction must be deferred by two layers");
+  static_assert(r6_t::LO == -2 * (ml_kem_field::Q16 - 1) && r6_t::HI == 2 * ml_kem_field::Q16, "Each coefficient must be ∈ [-2q, 2q]");
+
+  intt_last_layer(poly, r6);
+}
+
+// Given two degree-255 polynomials in NTT form, with coefficients ∈ (-q, q), this routine performs 128 base case multiplications
+// for 128 pairs of degree-1 polynomials, writing canonical coefficients of h = f ◦ g.
+//
+// Each product is computed using Montgomery multiplication, leaving it scaled by R^-1, which is undone by multiplying with R^2.
+// Sums of two products are ∈ (-2q, 2q), which Montgomery multiplication by R^2 brings back to (-q, q), without any reduction.
+//
+// See algorithm 11, 12 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+constexpr void
+polymul(std::span<const int16_t, N> f, std::span<const int16_t, N> g, std::span<int16_t, N> h)
+{
+  using ml_kem_field::centered_t;
+
+  for (size_t i = 0; i < f.size() / 2; i++) {
+    const size_t off = i * 2;
+
+    const centered_t f0{ f[off + 0] }, f1{ f[off + 1] };
+    const centered_t g0{ g[off + 0] }, g1{ g[off + 1] };
+
+    const auto t0 = ml_kem_field::fqmul(ml_kem_field::fqmul(f1, g1), POLY_MUL_TWIDDLES[i].zeta);
+    const auto h0 = ml_kem_field::fqmul(f0, g0) + t0;
+    const auto h1 = ml_kem_field::fqmul(f0, g1) + ml_kem_field::fqmul(f1, g0);
+
+    h[off + 0] = ml_kem_field::canonicalize(ml_kem_field::fqmul(h0, ml_kem_field::R2_MOD_Q)).v;
+    h[off + 1] = ml_kem_field::canonicalize(ml_kem_field::fqmul(h1, ml_kem_field::R2_MOD_Q)).v;
+  }
+}
+
+// Given `cnt` pairs of degree-255 polynomials in NTT form, with coefficients ∈ (-q, q), this routine computes the sum of their
+// products h = Σ f_i ◦ g_i, writing canonical coefficients. It is the fused multiply-accumulate kernel, computing one row of a
+// matrix-vector product in NTT domain, where `f` is a row of the matrix and `g` is the vector.
+//
+// Products of coefficients are accumulated in 32 -bit, unreduced form, while Montgomery reduction is applied only once for each
+// output coefficient. When `karatsuba` is set, f0 * g1 + f1 * g0 is computed as (f0 + f1) * (g0 + g1) - f0 * g0 - f1 * g1, which
+// needs four multiplications per base case multiplication, instead of five.
+template<size_t cnt, bool karatsuba = ML_KEM_KARATSUBA_BASEMUL != 0>
+constexpr void
+polymul_acc(std::span<const int16_t, cnt * N> f, std::span<const int16_t, cnt * N> g, std::span<int16_t, N> h)
+{
+  // Bound proof: each of `cnt` terms adds at most 2 * (q - 1)^2 to absolute value of accumulators, which must stay within input
+  // domain of Montgomery reduction.
+  constexpr int64_t max_term = 2 * static_cast<int64_t>(ml_kem_field::Q16 - 1) * (ml_kem_field::Q16 - 1);
+  static_assert(static_cast<int64_t>(cnt) * max_term < (static_cast<int64_t>(ml_kem_field::Q) << 15), "Accumulator must not overflow");
+
+  for (size_t i = 0; i < N / 2; i++) {
+    const size_t off = i * 2;
+    const int32_t zeta = POLY_MUL_TWIDDLES[i].zeta;
+
+    int32_t h0 = 0;
+    int32_t h1 = 0;
+
+    for (size_t j = 0; j < cnt; j++) {
+      const size_t poff = j * N + off;
+
+      const int32_t f0 = f[poff + 0];
+      const int32_t f1 = f[poff + 1];
+      const int32_t g0 = g[poff + 0];
+      const int32_t g1 = g[poff + 1];
+
+      const int32_t f0g0 = f0 * g0;
+      const int32_t f1g1 = f1 * g1;
+
+      h0 += f0g0 + (ml_kem_field::montgomery_reduce(f1g1) * zeta);
+      if constexpr (karatsuba) {
+        h1 += ((f0 + f1) * (g0 + g1)) - f0g0 - f1g1;
+      } else {
+        h1 += (f0 * g1) + (f1 * g0);
+      }
+    }
+
+    // Montgomery reduction leaves sums scaled by R^-1, which is undone by multiplying with R^2.
+    h[off + 0] = ml_kem_field::canonicalize(ml_kem_field::fqmul(ml_kem_field::montgomery_reduce(h0), ml_kem_field::R2_MOD_Q));
+    h[off + 1] = ml_kem_field::canonicalize(ml_kem_field::fqmul(ml_kem_field::montgomery_reduce(h1), ml_kem_field::R2_MOD_Q));
+  }
+}
+
+// Given a polynomial g in NTT form, with coefficients ∈ (-q, q), this routine computes its multiplication cache, holding
+// g[2i + 1] * ζ^(2·br(i) + 1) ∈ (-q, q), for each of 128 degree-1 polynomials. When g is multiplied with many polynomials, caching
+// it saves one Montgomery multiplication per base case multiplication ( see `polymul_acc` below ).
+constexpr void
+mulcache(std::span<const int16_t, N> g, std::span<int16_t, N / 2> cache)
+{
+  for (size_t i = 0; i < cache.size(); i++) {
+    cache[i] = ml_kem_field::fqmul(g[2 * i + 1], POLY_MUL_TWIDDLES[i].zeta);
+  }
+}
+
+// Same as `polymul_acc` above, but using multiplication cache of each of g_i, computed by `mulcache`, so that
+// f0 * g0 + f1 * g1 * ζ is computed using two multiplications only. Karatsuba's trick doesn't reduce multiplication count any
+// further, so it is not used here.
+template<size_t cnt>
+constexpr void
+polymul_acc(std::span<const int16_t, cnt * N> f,
+            std::span<const int16_t, cnt * N> g,
+            std::span<const int16_t, cnt * N / 2> g_cache,
+            std::span<int16_t, N> h)
+{
+  // Bound proof: each of `cnt` terms adds at most 2 * (q - 1)^2 to absolute value of accumulators, as cached values are ∈ (-q, q).
+  constexpr int64_t max_term = 2 * static_cast<int64_t>(ml_kem_field::Q16 - 1) * (ml_kem_field::Q16 - 1);
+  static_assert(static_cast<int64_t>(cnt) * max_term < (static_cast<int64_t>(ml_kem_field::Q) << 15), "Accumulator must not overflow");
+
+  for (size_t i = 0; i < N / 2; i++) {
+    const size_t off = i * 2;
+
+    int32_t h0 = 0;
+    int32_t h1 = 0;
+
+    for (size_t j = 0; j < cnt; j++) {
+      const size_t poff = j * N + off;
+
+      const int32_t f0 = f[poff + 0];
+      const int32_t f1 = f[poff + 1];
+      const int32_t g0 = g[poff + 0];
+      const int32_t g1 = g[poff + 1];
+      const int32_t g1_zeta = g_cache[j * (N / 2) + i];
+
+      h0 += (f0 * g0) + (f1 * g1_zeta);
+      h1 += (f0 * g1) + (f1 * g0);
+    }
+
+    h[off + 0] = ml_kem_field::canonicalize(ml_kem_field::fqmul(ml_kem_field::montgomery_reduce(h0), ml_kem_field::R2_MOD_Q));
+    h[off + 1] = ml_kem_field::canonicalize(ml_kem_field::fqmul(ml_kem_field::montgomery_reduce(h1), ml_kem_field::R2_MOD_Q));
+  }
+}
+
+}
+
+namespace ml_kem_ntt {
+
+// Forward NTT of a polynomial, dispatching to the fastest implementation supported by executing CPU.
+// See `ml_kem_ntt::scalar::ntt` for description of the transform.
+forceinline constexpr void
+ntt(std::span<ml_kem_field::zq_t, N> poly)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::ntt(poly);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::ntt(poly);
+      return;
+    }
+  }
+#endif
+
+  scalar::ntt(poly);
+}
+
+// Inverse NTT of a polynomial, dispatching to the fastest implementation supported by executing CPU.
+// See `ml_kem_ntt::scalar::intt` for description of the transform.
+forceinline constexpr void
+intt(std::span<ml_kem_field::zq_t, N> poly)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::intt(poly);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::intt(poly);
+      return;
+    }
+  }
+#endif
+
+  scalar::intt(poly);
+}
+
+// Multiplication of two polynomials in NTT domain, dispatching to the fastest implementation supported by executing CPU.
+// See `ml_kem_ntt::scalar::polymul` for description of the algorithm.
+forceinline constexpr void
+polymul(std::span<const ml_kem_field::zq_t, N> f, std::span<const ml_kem_field::zq_t, N> g, std::span<ml_kem_field::zq_t, N> h)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::polymul(f, g, h);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::polymul(f, g, h);
+      return;
+    }
+  }
+#endif
+
+  scalar::polymul(f, g, h);
+}
+
+// Forward NTT of a polynomial with signed 16 -bit coefficients ∈ (-q, q), dispatching to the fastest implementation supported by
+// executing CPU. Output coefficients are ∈ [0, q).
+forceinline constexpr void
+ntt(std::span<int16_t, N> poly)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::ntt(poly);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::ntt(poly);
+      return;
+    }
+  }
+#endif
+
+  scalar::ntt(poly);
+}
+
+// Inverse NTT of a polynomial with signed 16 -bit coefficients ∈ (-q, q), dispatching to the fastest implementation supported by
+// executing CPU. Output coefficients are ∈ [0, q).
+forceinline constexpr void
+intt(std::span<int16_t, N> poly)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::intt(poly);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::intt(poly);
+      return;
+    }
+  }
+#endif
+
+  scalar::intt(poly);
+}
+
+// Multiplication of two polynomials in NTT domain, with signed 16 -bit coefficients ∈ (-q, q), dispatching to the fastest
+// implementation supported by executing CPU. Output coefficients are ∈ [0, q).
+forceinline constexpr void
+polymul(std::span<const int16_t, N> f, std::span<const int16_t, N> g, std::span<int16_t, N> h)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::polymul(f, g, h);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::polymul(f, g, h);
+      return;
+    }
+  }
+#endif
+
+  scalar::polymul(f, g, h);
+}
+
+// Sum of products of `cnt` pairs of polynomials in NTT domain, with signed 16 -bit coefficients ∈ (-q, q), dispatching to the fastest
+// implementation supported by executing CPU. Output coefficients are ∈ [0, q).
+template<size_t cnt>
+forceinline constexpr void
+polymul_acc(std::span<const int16_t, cnt * N> f, std::span<const int16_t, cnt * N> g, std::span<int16_t, N> h)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::polymul_acc<cnt>(f, g, h);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::polymul_acc<cnt>(f, g, h);
+      return;
+    }
+  }
+#endif
+
+  scalar::polymul_acc<cnt>(f, g, h);
+}
+
+// Multiplication cache of a polynomial is computed only once, while being used many times, so it has no vectorized implementation.
+using scalar::mulcache;
+
+// Sum of products of `cnt` pairs of polynomials in NTT domain, using multiplication cache of each of g_i, dispatching to the fastest
+// implementation supported by executing CPU. Output coefficients are ∈ [0, q).
+template<size_t cnt>
+forceinline constexpr void
+polymul_acc(std::span<const int16_t, cnt * N> f,
+            std::span<const int16_t, cnt * N> g,
+            std::span<const int16_t, cnt * N / 2> g_cache,
+            std::span<int16_t, N> h)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      avx512::polymul_acc<cnt>(f, g, g_cache, h);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      avx2::polymul_acc<cnt>(f, g, g_cache, h);
+      return;
+    }
+  }
+#endif
+
+  scalar::polymul_acc<cnt>(f, g, g_cache, h);
+}
+
+}
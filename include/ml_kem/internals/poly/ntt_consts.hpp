@@ -0,0 +1,97 @@
+#pragma once
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
+#include <array>
+#include <cstddef>
+
+namespace ml_kem_ntt {
+
+inline constexpr size_t LOG2N = 8;
+inline constexpr size_t N = 1 << LOG2N;
+
+// First primitive 256 -th root of unity modulo q | q = 3329
+//
+// Meaning, 17 ** 256 == 1 mod q
+inline constexpr auto ZETA = ml_kem_field::zq_t(17);
+static_assert((ZETA ^ N) == ml_kem_field::zq_t::one(), "ZETA must be 256th root of unity modulo Q");
+
+// Multiplicative inverse of N/ 2 over Z_q | q = 3329 and N = 256
+//
+// Meaning (N/ 2) * INV_N = 1 mod q
+inline constexpr auto INV_N = ml_kem_field::zq_t(N / 2).inv();
+
+// Given a 64 -bit unsigned integer, this routine extracts specified many contiguous bits from ( least significant bits ) LSB side
+// and reverses their bit order, returning bit reversed `mbw` -bit wide number.
+//
+// See https://github.com/itzmeanjan/falcon/blob/45b0593/include/ntt.hpp#L30-L38 for source of inspiration.
+template<size_t mbw>
+forceinline constexpr size_t // NOLINT(misc-include-cleaner)
+bit_rev(const size_t v)
+{
+  size_t v_rev = 0UL;
+
+  for (size_t i = 0; i < mbw; i++) {
+    const size_t bit = (v >> i) & 0b1;
+    v_rev ^= bit << (mbw - 1UL - i);
+  }
+
+  return v_rev;
+}
+
+// Compile-time computed constants ( powers of ζ ), used for polynomial evaluation i.e. computation of NTT form.
+inline constexpr std::array<ml_kem_field::zq_t, N / 2> NTT_ZETA_EXP = []() -> auto {
+  std::array<ml_kem_field::zq_t, N / 2> res{};
+
+  for (size_t i = 0; i < res.size(); i++) {
+    res[i] = ZETA ^ bit_rev<LOG2N - 1>(i);
+  }
+
+  return res;
+}();
+
+// Compile-time computed constants ( negated powers of ζ ), used for polynomial interpolation i.e. computation of iNTT form.
+inline constexpr std::array<ml_kem_field::zq_t, N / 2> INTT_ZETA_EXP = []() -> auto {
+  std::array<ml_kem_field::zq_t, N / 2> res{};
+
+  for (size_t i = 0; i < res.size(); i++) {
+    res[i] = -NTT_ZETA_EXP[i];
+  }
+
+  return res;
+}();
+
+// Compile-time computed constants ( powers of ζ ), used when multiplying two degree-255 polynomials in NTT domain.
+inline constexpr std::array<ml_kem_field::zq_t, N / 2> POLY_MUL_ZETA_EXP = []() -> auto {
+  std::array<ml_kem_field::zq_t, N / 2> res{};
+
+  for (size_t i = 0; i < res.size(); i++) {
+    res[i] = ZETA ^ ((bit_rev<LOG2N - 1>(i) << 1) ^ 1);
+  }
+
+  return res;
+}();
+
+// Montgomery forms of powers of ζ, used by kernels operating on signed 16 -bit coefficients ( see `ml_kem_field::fqmul` ).
+template<size_t n>
+constexpr std::array<ml_kem_field::twiddle_t, n>
+make_twiddles(const std::array<ml_kem_field::zq_t, n>& zetas)
+{
+  std::array<ml_kem_field::twiddle_t, n> res{};
+  for (size_t i = 0; i < n; i++) {
+    res[i] = ml_kem_field::make_twiddle(zetas[i]);
+  }
+  return res;
+}
+
+inline constexpr auto NTT_TWIDDLES = make_twiddles(NTT_ZETA_EXP);
+inline constexpr auto INTT_TWIDDLES = make_twiddles(INTT_ZETA_EXP);
+inline constexpr auto POLY_MUL_TWIDDLES = make_twiddles(POLY_MUL_ZETA_EXP);
+
+// Montgomery form of N^-1 ( see `INV_N` ), used for scaling output of inverse NTT.
+inline constexpr ml_kem_field::twiddle_t INV_N_TWIDDLE = ml_kem_field::make_twiddle(INV_N);
+
+// Montgomery form of ζ * N^-1, where ζ is the twiddle factor of last layer of inverse NTT, into which scaling by N^-1 is folded.
+inline constexpr ml_kem_field::twiddle_t INTT_LAST_TWIDDLE = ml_kem_field::make_twiddle(INTT_ZETA_EXP[1] * INV_N);
+
+}
@@ -1,9 +1,12 @@
 #pragma once
 #include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/unreduced.hpp"
 #include "ml_kem/internals/poly/compression.hpp"
 #include "ml_kem/internals/poly/ntt.hpp"
+#include "ml_kem/internals/poly/sampling.hpp"
 #include "ml_kem/internals/poly/serialize.hpp"
 #include "ml_kem/internals/utility/params.hpp"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
@@ -12,45 +15,93 @@
 namespace ml_kem_utils {
 
 // Given two matrices ( in NTT domain ) of compatible dimension, where each matrix element is a degree-255 polynomial over Z_q | q = 3329,
-// this routine multiplies them, computing a resulting matrix.
+// with signed 16 -bit coefficients ∈ (-q, q), this routine multiplies them, computing a resulting matrix with canonical coefficients.
+//
+// Each element of the resulting matrix is computed by one call to the fused multiply-accumulate kernel `ml_kem_ntt::polymul_acc`,
+// which accumulates all `a_cols` products in unreduced form, reducing them only once.
 template<size_t a_rows, size_t a_cols, size_t b_rows, size_t b_cols>
 constexpr void
-matrix_multiply(std::span<const ml_kem_field::zq_t, a_rows * a_cols * ml_kem_ntt::N> a,
-                std::span<const ml_kem_field::zq_t, b_rows * b_cols * ml_kem_ntt::N> b,
-                std::span<ml_kem_field::zq_t, a_rows * b_cols * ml_kem_ntt::N> c)
+matrix_multiply(std::span<const int16_t, a_rows * a_cols * ml_kem_ntt::N> a,
+                std::span<const int16_t, b_rows * b_cols * ml_kem_ntt::N> b,
+                std::span<int16_t, a_rows * b_cols * ml_kem_ntt::N> c)
   requires(ml_kem_params::check_matrix_dim(a_cols, b_rows))
 {
-  using poly_t = std::span<const ml_kem_field::zq_t, ml_kem_ntt::N>;
+  using row_t = std::span<const int16_t, a_cols * ml_kem_ntt::N>;
+  using poly_t = std::span<int16_t, ml_kem_ntt::N>;
 
-  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> tmp{};
-  auto tmp_span = std::span(tmp);
-
-  for (size_t i = 0; i < a_rows; i++) {
-    for (size_t j = 0; j < b_cols; j++) {
+  const auto mul_col = [&](const row_t b_col, const size_t j) {
+    for (size_t i = 0; i < a_rows; i++) {
+      const size_t aoff = i * a_cols * ml_kem_ntt::N;
       const size_t coff = (i * b_cols + j) * ml_kem_ntt::N;
 
-      for (size_t k = 0; k < a_cols; k++) {
-        const size_t aoff = (i * a_cols + k) * ml_kem_ntt::N;
-        const size_t boff = (k * b_cols + j) * ml_kem_ntt::N;
+      ml_kem_ntt::polymul_acc<a_cols>(row_t(a.subspan(aoff, a_cols * ml_kem_ntt::N)), b_col, poly_t(c.subspan(coff, ml_kem_ntt::N)));
+    }
+  };
 
-        ml_kem_ntt::polymul(poly_t(a.subspan(aoff, ml_kem_ntt::N)), poly_t(b.subspan(boff, ml_kem_ntt::N)), tmp_span);
+  if constexpr (b_cols == 1) {
+    mul_col(b, 0);
+  } else {
+    // Columns of `b` are contiguous in memory only when it is a column vector, otherwise they are gathered.
+    std::array<int16_t, b_rows * ml_kem_ntt::N> col{};
 
-        for (size_t idx = 0; idx < ml_kem_ntt::N; idx++) {
-          c[coff + idx] += tmp[idx];
-        }
+    for (size_t j = 0; j < b_cols; j++) {
+      for (size_t k = 0; k < b_rows; k++) {
+        const auto poly = b.subspan((k * b_cols + j) * ml_kem_ntt::N, ml_kem_ntt::N);
+        std::copy(poly.begin(), poly.end(), col.begin() + static_cast<ptrdiff_t>(k * ml_kem_ntt::N));
       }
+
+      mul_col(col, j);
     }
   }
 }
 
+// Same as `matrix_multiply` above, but `b` must be a column vector, whose multiplication cache ( see `poly_vec_mulcache` ) is also
+// supplied. Pays off when `b` is multiplied with more than one row.
+template<size_t a_rows, size_t a_cols, size_t b_rows, size_t b_cols>
+constexpr void
+matrix_multiply(std::span<const int16_t, a_rows * a_cols * ml_kem_ntt::N> a,
+                std::span<const int16_t, b_rows * b_cols * ml_kem_ntt::N> b,
+                std::span<const int16_t, b_rows * b_cols * ml_kem_ntt::N / 2> b_cache,
+                std::span<int16_t, a_rows * b_cols * ml_kem_ntt::N> c)
+  requires(ml_kem_params::check_matrix_dim(a_cols, b_rows) && (b_cols == 1))
+{
+  using row_t = std::span<const int16_t, a_cols * ml_kem_ntt::N>;
+  using poly_t = std::span<int16_t, ml_kem_ntt::N>;
+
+  for (size_t i = 0; i < a_rows; i++) {
+    const size_t off = i * ml_kem_ntt::N;
+    ml_kem_ntt::polymul_acc<a_cols>(row_t(a.subspan(off * a_cols, a_cols * ml_kem_ntt::N)), b, b_cache, poly_t(c.subspan(off, ml_kem_ntt::N)));
+  }
+}
+
+// Same as `matrix_multiply` above, multiplying public matrix A ( or its transpose ) with column vector `b`, whose multiplication cache is
+// also supplied, but the matrix is never materialized. Instead it is expanded from seed ρ, one row at a time, in supplied `row` buffer,
+// and each row is multiplied with `b` right after being sampled, s.t. the working set is a single row of k polynomials, instead of k x k.
+template<size_t k, bool transpose>
+constexpr void
+expand_matrix_multiply(std::span<const uint8_t, 32> rho,
+                       std::span<const int16_t, k * ml_kem_ntt::N> b,
+                       std::span<const int16_t, k * ml_kem_ntt::N / 2> b_cache,
+                       std::span<int16_t, k * ml_kem_ntt::N> c,
+                       std::span<int16_t, k * ml_kem_ntt::N> row)
+  requires(ml_kem_params::check_k(k))
+{
+  using poly_t = std::span<int16_t, ml_kem_ntt::N>;
+
+  for (size_t i = 0; i < k; i++) {
+    ml_kem_utils::generate_matrix_row<k, transpose>(row, rho, i);
+    ml_kem_ntt::polymul_acc<k>(row, b, b_cache, poly_t(c.subspan(i * ml_kem_ntt::N, ml_kem_ntt::N)));
+  }
+}
+
 // Given a vector ( of dimension `k x 1` ) of degree-255 polynomials ( where polynomial coefficients are in non-NTT form ),
 // this routine applies in-place polynomial NTT over `k` polynomials.
 template<size_t k>
 constexpr void
-poly_vec_ntt(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
+poly_vec_ntt(std::span<int16_t, k * ml_kem_ntt::N> vec)
   requires((k == 1) || ml_kem_params::check_k(k))
 {
-  using poly_t = std::span<ml_kem_field::zq_t, ml_kem_ntt::N>;
+  using poly_t = std::span<int16_t, ml_kem_ntt::N>;
 
   for (size_t i = 0; i < k; i++) {
     const size_t off = i * ml_kem_ntt::N;
@@ -58,14 +109,29 @@ poly_vec_ntt(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
   }
 }
 
+// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials in NTT form, this routine computes multiplication cache of each of
+// those `k` polynomials, to be used when the vector is multiplied with more than one row of a matrix.
+template<size_t k>
+constexpr void
+poly_vec_mulcache(std::span<const int16_t, k * ml_kem_ntt::N> vec, std::span<int16_t, k * ml_kem_ntt::N / 2> cache)
+  requires((k == 1) || ml_kem_params::check_k(k))
+{
+  using poly_t = std::span<const int16_t, ml_kem_ntt::N>;
+  using cache_t = std::span<int16_t, ml_kem_ntt::N / 2>;
+
+  for (size_t i = 0; i < k; i++) {
+    ml_kem_ntt::mulcache(poly_t(vec.subspan(i * ml_kem_ntt::N, ml_kem_ntt::N)), cache_t(cache.subspan(i * ml_kem_ntt::N / 2, ml_kem_ntt::N / 2)));
+  }
+}
+
 // Given a vector ( of dimension `k x 1` ) of degree-255 polynomials ( where polynomial coefficients are in NTT form i.e.
 // they are placed in bit-reversed order ), this routine applies in-place polynomial iNTT over those `k` polynomials.
 template<size_t k>
 constexpr void
-poly_vec_intt(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
+poly_vec_intt(std::span<int16_t, k * ml_kem_ntt::N> vec)
   requires((k == 1) || ml_kem_params::check_k(k))
 {
-  using poly_t = std::span<ml_kem_field::zq_t, ml_kem_ntt::N>;
+  using poly_t = std::span<int16_t, ml_kem_ntt::N>;
 
   for (size_t i = 0; i < k; i++) {
     const size_t off = i * ml_kem_ntt::N;
@@ -73,29 +139,37 @@ poly_vec_intt(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
   }
 }
 
-// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, this routine adds it to another polynomial vector of same dimension.
+// Range of coefficients, which polynomial vectors are allowed to have, before being lazily added to or subtracted from.
+using lazy_dst_t = ml_kem_field::unreduced_t<-(2 * ml_kem_field::Q16 - 1), 2 * ml_kem_field::Q16 - 1>;
+using lazy_src_t = ml_kem_field::centered_t;
+
+// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, with coefficients ∈ (-q, q), this routine adds it to another
+// polynomial vector of same dimension, with coefficients ∈ (-2q, 2q). Resulting coefficients are ∈ (-3q, 3q), they are not reduced,
+// as they are fully reduced only when serialized ( see `encode`, `poly_compress` ).
 template<size_t k>
 constexpr void
-poly_vec_add_to(std::span<const ml_kem_field::zq_t, k * ml_kem_ntt::N> src, std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> dst)
+poly_vec_add_to(std::span<const int16_t, k * ml_kem_ntt::N> src, std::span<int16_t, k * ml_kem_ntt::N> dst)
   requires((k == 1) || ml_kem_params::check_k(k))
 {
   constexpr size_t cnt = k * ml_kem_ntt::N;
 
   for (size_t i = 0; i < cnt; i++) {
-    dst[i] += src[i];
+    dst[i] = (lazy_dst_t{ dst[i] } + lazy_src_t{ src[i] }).v;
   }
 }
 
-// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, this routine subtracts it to another polynomial vector of same dimension.
+// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, with coefficients ∈ (-q, q), this routine subtracts it from
+// another polynomial vector of same dimension, with coefficients ∈ (-2q, 2q). Resulting coefficients are ∈ (-3q, 3q), they are not
+// reduced, as they are fully reduced only when serialized ( see `encode`, `poly_compress` ).
 template<size_t k>
 constexpr void
-poly_vec_sub_from(std::span<const ml_kem_field::zq_t, k * ml_kem_ntt::N> src, std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> dst)
+poly_vec_sub_from(std::span<const int16_t, k * ml_kem_ntt::N> src, std::span<int16_t, k * ml_kem_ntt::N> dst)
   requires((k == 1) || ml_kem_params::check_k(k))
 {
   constexpr size_t cnt = k * ml_kem_ntt::N;
 
   for (size_t i = 0; i < cnt; i++) {
-    dst[i] -= src[i];
+    dst[i] = (lazy_dst_t{ dst[i] } - lazy_src_t{ src[i] }).v;
   }
 }
 
@@ -103,10 +177,10 @@ poly_vec_sub_from(std::span<const ml_kem_field::zq_t, k * ml_kem_ntt::N> src, st
 // writing to a (k x 32 x l) -bytes destination array.
 template<size_t k, size_t l>
 constexpr void
-poly_vec_encode(std::span<const ml_kem_field::zq_t, k * ml_kem_ntt::N> src, std::span<uint8_t, k * 32 * l> dst)
+poly_vec_encode(std::span<const int16_t, k * ml_kem_ntt::N> src, std::span<uint8_t, k * 32 * l> dst)
   requires(ml_kem_params::check_k(k))
 {
-  using poly_t = std::span<const ml_kem_field::zq_t, src.size() / k>;
+  using poly_t = std::span<const int16_t, src.size() / k>;
   using serialized_t = std::span<uint8_t, dst.size() / k>;
 
   for (size_t i = 0; i < k; i++) {
@@ -121,11 +195,11 @@ poly_vec_encode(std::span<const ml_kem_field::zq_t, k * ml_kem_ntt::N> src, std:
 // column vector of dimension `k x 1`.
 template<size_t k, size_t l>
 constexpr void
-poly_vec_decode(std::span<const uint8_t, k * 32 * l> src, std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> dst)
+poly_vec_decode(std::span<const uint8_t, k * 32 * l> src, std::span<int16_t, k * ml_kem_ntt::N> dst)
   requires(ml_kem_params::check_k(k))
 {
   using serialized_t = std::span<const uint8_t, src.size() / k>;
-  using poly_t = std::span<ml_kem_field::zq_t, dst.size() / k>;
+  using poly_t = std::span<int16_t, dst.size() / k>;
 
   for (size_t i = 0; i < k; i++) {
     const size_t off0 = i * l * 32;
@@ -135,13 +209,35 @@ poly_vec_decode(std::span<const uint8_t, k * 32 * l> src, std::span<ml_kem_field
   }
 }
 
+// Same as `poly_vec_decode<k, 12>` above, but also checking, in the same pass, whether any of k * 256 decoded 12 -bit coefficients is ≥ q.
+// Returns truth value (0xffffffff) if at least one of them is, otherwise it returns false value (0x00000000), computed in constant-time.
+template<size_t k>
+constexpr uint32_t
+poly_vec_decode_checked(std::span<const uint8_t, k * 32 * 12> src, std::span<int16_t, k * ml_kem_ntt::N> dst)
+  requires(ml_kem_params::check_k(k))
+{
+  using serialized_t = std::span<const uint8_t, src.size() / k>;
+  using poly_t = std::span<int16_t, dst.size() / k>;
+
+  uint32_t non_canonical = 0;
+
+  for (size_t i = 0; i < k; i++) {
+    const size_t off0 = i * 12 * 32;
+    const size_t off1 = i * ml_kem_ntt::N;
+
+    non_canonical |= ml_kem_utils::decode_checked<12>(serialized_t(src.subspan(off0, 32 * 12)), poly_t(dst.subspan(off1, ml_kem_ntt::N)));
+  }
+
+  return non_canonical;
+}
+
 // Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, each of k * 256 coefficients are compressed, while mutating input.
 template<size_t k, size_t d>
 constexpr void
-poly_vec_compress(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
+poly_vec_compress(std::span<int16_t, k * ml_kem_ntt::N> vec)
   requires(ml_kem_params::check_k(k))
 {
-  using poly_t = std::span<ml_kem_field::zq_t, vec.size() / k>;
+  using poly_t = std::span<int16_t, vec.size() / k>;
 
   for (size_t i = 0; i < k; i++) {
     const size_t off = i * ml_kem_ntt::N;
@@ -152,10 +248,10 @@ poly_vec_compress(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
 // Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, each of k * 256 coefficients are decompressed, while mutating input.
 template<size_t k, size_t d>
 constexpr void
-poly_vec_decompress(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
+poly_vec_decompress(std::span<int16_t, k * ml_kem_ntt::N> vec)
   requires(ml_kem_params::check_k(k))
 {
-  using poly_t = std::span<ml_kem_field::zq_t, vec.size() / k>;
+  using poly_t = std::span<int16_t, vec.size() / k>;
 
   for (size_t i = 0; i < k; i++) {
     const size_t off = i * ml_kem_ntt::N;
@@ -163,4 +259,40 @@ poly_vec_decompress(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec)
   }
 }
 
+// Given a vector ( of dimension `k x 1` ) of degree-255 polynomials, this routine compresses and encodes each of those polynomials into
+// 32 x d -bytes, in a single pass, writing to a (k x 32 x d) -bytes destination array.
+template<size_t k, size_t d>
+constexpr void
+poly_vec_compress_encode(std::span<const int16_t, k * ml_kem_ntt::N> src, std::span<uint8_t, k * 32 * d> dst)
+  requires(ml_kem_params::check_k(k))
+{
+  using poly_t = std::span<const int16_t, src.size() / k>;
+  using serialized_t = std::span<uint8_t, dst.size() / k>;
+
+  for (size_t i = 0; i < k; i++) {
+    const size_t off0 = i * ml_kem_ntt::N;
+    const size_t off1 = i * d * 32;
+
+    ml_kem_utils::compress_encode<d>(poly_t(src.subspan(off0, ml_kem_ntt::N)), serialized_t(dst.subspan(off1, 32 * d)));
+  }
+}
+
+// Given a byte array of length (k x 32 x d) -bytes, this routine decodes and decompresses them into k degree-255 polynomials, in a single
+// pass, writing them to a column vector of dimension `k x 1`.
+template<size_t k, size_t d>
+constexpr void
+poly_vec_decode_decompress(std::span<const uint8_t, k * 32 * d> src, std::span<int16_t, k * ml_kem_ntt::N> dst)
+  requires(ml_kem_params::check_k(k))
+{
+  using serialized_t = std::span<const uint8_t, src.size() / k>;
+  using poly_t = std::span<int16_t, dst.size() / k>;
+
+  for (size_t i = 0; i < k; i++) {
+    const size_t off0 = i * d * 32;
+    const size_t off1 = i * ml_kem_ntt::N;
+
+    ml_kem_utils::decode_decompress<d>(serialized_t(src.subspan(off0, 32 * d)), poly_t(dst.subspan(off1, ml_kem_ntt::N)));
+  }
+}
+
 }
@@ -1,8 +1,12 @@
 #pragma once
+#include "ml_kem/internals/arch/avx2/sampling.hpp"
+#include "ml_kem/internals/keccak/shake_xn.hpp"
 #include "ml_kem/internals/math/field.hpp"
 #include "ml_kem/internals/poly/ntt.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
 #include "ml_kem/internals/utility/force_inline.hpp" // IWYU pragma: keep
 #include "ml_kem/internals/utility/params.hpp"
+#include "ml_kem/internals/utility/utils.hpp"
 #include "sha3/shake128.hpp"
 #include "sha3/shake256.hpp"
 #include <algorithm>
@@ -11,9 +15,68 @@
 #include <cstdint>
 #include <limits>
 #include <span>
+#include <type_traits>
 
 namespace ml_kem_utils {
 
+// Number of SHAKE128 blocks squeezed up front, for sampling a polynomial in NTT representation. Those 672 bytes carry 448 candidate
+// coefficients, each accepted with probability q / 2^12, while 256 of them are to be accepted. Probability of running short of that,
+// requiring more blocks to be squeezed, is < 2^-105.
+inline constexpr size_t REJ_UNIFORM_BLOCKS = 4;
+
+// Statistics of sampling a polynomial in NTT representation, using rejection sampling, reported for testing.
+struct rej_stats_t
+{
+  size_t rejected = 0;     // Number of parsed candidate coefficients, which were >= q
+  size_t extra_blocks = 0; // Number of SHAKE128 blocks squeezed, after the fixed budget got exhausted
+};
+
+// Given XOF output of length multiple of 3, this routine parses it as a sequence of 12 -bit candidate coefficients, appending those
+// which are less than q to `poly`, starting at `coeff_idx`, until all coefficients are sampled. Returns index of next coefficient to be
+// sampled, while `rejected` is incremented by number of parsed candidates which were rejected. Coefficients can either be `zq_t` or
+// signed 16 -bit integers, in both cases they are canonical.
+//
+// Each candidate is written to the next free slot of `poly`, irrespective of whether it is accepted, so that acceptance only decides
+// whether the slot is advanced or not. Only the last candidate of a pair may find `poly` already filled, it is then not written.
+//
+// See step (4-15) of algorithm 7 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+template<typename coeff_t>
+forceinline constexpr size_t // NOLINT(misc-include-cleaner)
+parse_ntt_coeffs(std::span<const uint8_t> buf, std::span<coeff_t, ml_kem_ntt::N> poly, size_t coeff_idx, size_t& rejected)
+{
+  constexpr size_t n = poly.size();
+
+  for (size_t off = 0; (off < buf.size()) && (coeff_idx < n); off += 3) {
+    const uint16_t d1 = static_cast<uint16_t>((static_cast<uint16_t>(buf[off + 1] & 0x0f) << 8) | static_cast<uint16_t>(buf[off + 0]));
+    const uint16_t d2 = static_cast<uint16_t>((static_cast<uint16_t>(buf[off + 2]) << 4) | (static_cast<uint16_t>(buf[off + 1] >> 4)));
+
+    const auto accept1 = static_cast<size_t>(d1 < ml_kem_field::Q);
+
+    poly[coeff_idx] = static_cast<coeff_t>(d1);
+    coeff_idx += accept1;
+    rejected += accept1 ^ 1;
+
+    const auto pending = static_cast<size_t>(coeff_idx < n);
+    const auto accept2 = static_cast<size_t>(d2 < ml_kem_field::Q) & pending;
+    const size_t slot = std::min(coeff_idx, n - 1);
+
+    poly[slot] = (pending == 1) ? static_cast<coeff_t>(d2) : poly[slot];
+    coeff_idx += accept2;
+    rejected += pending & (accept2 ^ 1);
+  }
+
+  return coeff_idx;
+}
+
+// Same as above, when number of rejected candidates is of no interest.
+template<typename coeff_t>
+forceinline constexpr size_t
+parse_ntt_coeffs(std::span<const uint8_t> buf, std::span<coeff_t, ml_kem_ntt::N> poly, size_t coeff_idx)
+{
+  size_t rejected = 0;
+  return parse_ntt_coeffs(buf, poly, coeff_idx, rejected);
+}
+
 // Uniform sampling in R_q | q = 3329.
 //
 // Given a byte stream, this routine *deterministically* samples a degree 255 polynomial in NTT representation.
@@ -21,7 +84,7 @@ namespace ml_kem_utils {
 // statiscally close to randomly sampled elements of R_q.
 //
 // See algorithm 7 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
-forceinline constexpr void // NOLINT(misc-include-cleaner)
+forceinline constexpr void
 sample_ntt(shake128::shake128_t& hasher, std::span<ml_kem_field::zq_t, ml_kem_ntt::N> poly)
 {
   constexpr size_t n = poly.size();
@@ -31,33 +94,221 @@ sample_ntt(shake128::shake128_t& hasher, std::span<ml_kem_field::zq_t, ml_kem_nt
 
   while (coeff_idx < n) {
     hasher.squeeze(buf);
+    coeff_idx = parse_ntt_coeffs(buf, poly, coeff_idx);
+  }
+}
 
-    for (size_t off = 0; (off < buf.size()) && (coeff_idx < n); off += 3) {
-      const uint16_t d1 = static_cast<uint16_t>((static_cast<uint16_t>(buf[off + 1] & 0x0f) << 8) | static_cast<uint16_t>(buf[off + 0]));
-      const uint16_t d2 = static_cast<uint16_t>((static_cast<uint16_t>(buf[off + 2]) << 4) | (static_cast<uint16_t>(buf[off + 1] >> 4)));
+#if ML_KEM_X86_SIMD
+// Same as `parse_ntt_coeffs`, but parsing 16 candidates at a time using AVX2, while only the tail of `buf` is parsed by scalar code.
+// Produces exactly same coefficients and rejection count as `parse_ntt_coeffs` does.
+ML_KEM_TARGET_AVX2 inline size_t
+parse_ntt_coeffs_avx2(std::span<const uint8_t> buf, std::span<int16_t, ml_kem_ntt::N> poly, size_t coeff_idx, size_t& rejected)
+{
+  const size_t coeff_beg = coeff_idx;
+  const size_t off = avx2::rej_uniform(buf, poly, coeff_idx);
 
-      if (d1 < ml_kem_field::Q) {
-        poly[coeff_idx] = ml_kem_field::zq_t(d1);
-        coeff_idx++;
-      }
+  rejected += ((off / avx2::REJ_STEP_BYTES) * avx2::REJ_CANDIDATES) - (coeff_idx - coeff_beg);
+  return parse_ntt_coeffs(buf.subspan(off), poly, coeff_idx, rejected);
+}
+#endif
+
+// Parses the fixed budget of XOF output, squeezed up front, using vectorized rejection sampling, when executing CPU supports it.
+forceinline constexpr size_t
+parse_ntt_coeffs_budget(std::span<const uint8_t> buf, std::span<int16_t, ml_kem_ntt::N> poly, size_t& rejected)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    return parse_ntt_coeffs_avx2(buf, poly, 0, rejected);
+  }
+#endif
+
+  return parse_ntt_coeffs(buf, poly, 0, rejected);
+}
+
+// Same as above, but sampling a polynomial with signed 16 -bit coefficients, each ∈ [0, q). Instead of squeezing one block at a time,
+// until all coefficients are sampled, a fixed budget of `blocks` -many SHAKE128 blocks is squeezed up front, from which coefficients
+// are parsed without any data-dependent squeezing. Only when the budget falls short, which is statistically negligible for the
+// default budget, remaining coefficients are sampled block by block, on the slow path. Returns statistics of rejection sampling.
+template<size_t blocks = REJ_UNIFORM_BLOCKS>
+forceinline constexpr rej_stats_t
+sample_ntt(shake128::shake128_t& hasher, std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(blocks > 0)
+{
+  constexpr size_t n = poly.size();
+  constexpr size_t rate = shake128::RATE / std::numeric_limits<uint8_t>::digits;
+
+  rej_stats_t stats{};
+
+  std::array<uint8_t, blocks * rate> budget{};
+  hasher.squeeze(budget);
+
+  size_t coeff_idx = parse_ntt_coeffs_budget(budget, poly, stats.rejected);
+
+  std::array<uint8_t, rate> buf{};
+  while (coeff_idx < n) {
+    hasher.squeeze(buf);
+    coeff_idx = parse_ntt_coeffs(buf, poly, coeff_idx, stats.rejected);
+    stats.extra_blocks++;
+  }
+
+  return stats;
+}
+
+// Same as above, but sampling `lanes` -many polynomials at once, from as many SHAKE128 streams, computed in lock-step by a multi-lane
+// XOF. As all lanes squeeze the same fixed budget, they stay in lock-step, unless some lane falls short. Each polynomial is identical
+// to what `sample_ntt` would produce for respective stream. Returns statistics of rejection sampling, for each lane.
+template<size_t lanes, size_t rate, size_t blocks = REJ_UNIFORM_BLOCKS>
+constexpr std::array<rej_stats_t, lanes>
+sample_ntt(ml_kem_keccak::shake_xn_t<lanes, rate>& hasher, std::array<std::span<int16_t>, lanes> polys)
+  requires(blocks > 0)
+{
+  constexpr size_t n = ml_kem_ntt::N;
+
+  std::array<rej_stats_t, lanes> stats{};
+  std::array<size_t, lanes> coeff_idx{};
+
+  std::array<std::array<uint8_t, blocks * rate>, lanes> budgets{};
+  std::array<std::span<uint8_t>, lanes> budget_outs{};
+  for (size_t j = 0; j < lanes; j++) {
+    budget_outs[j] = budgets[j];
+  }
 
-      if ((d2 < ml_kem_field::Q) && (coeff_idx < n)) {
-        poly[coeff_idx] = ml_kem_field::zq_t(d2);
-        coeff_idx++;
-      }
+  hasher.squeeze(budget_outs);
+
+  bool done = true;
+  for (size_t j = 0; j < lanes; j++) {
+    coeff_idx[j] = parse_ntt_coeffs_budget(budgets[j], polys[j].template first<n>(), stats[j].rejected);
+    done &= coeff_idx[j] == n;
+  }
+
+  std::array<std::array<uint8_t, rate>, lanes> bufs{};
+  std::array<std::span<uint8_t>, lanes> outs{};
+  for (size_t j = 0; j < lanes; j++) {
+    outs[j] = bufs[j];
+  }
+
+  while (!done) {
+    hasher.squeeze(outs);
+
+    done = true;
+    for (size_t j = 0; j < lanes; j++) {
+      stats[j].extra_blocks += static_cast<size_t>(coeff_idx[j] < n);
+      coeff_idx[j] = parse_ntt_coeffs(bufs[j], polys[j].template first<n>(), coeff_idx[j], stats[j].rejected);
+      done &= coeff_idx[j] == n;
+    }
+  }
+
+  return stats;
+}
+
+// Sets last two bytes of SHAKE128 input, used for sampling entry (i, j) of matrix A ( or its transpose ).
+template<bool transpose>
+forceinline constexpr void
+set_matrix_xof_nonces(std::span<uint8_t, 34> xof_in, const size_t i, const size_t j)
+{
+  if constexpr (transpose) {
+    xof_in[32] = static_cast<uint8_t>(i);
+    xof_in[33] = static_cast<uint8_t>(j);
+  } else {
+    xof_in[32] = static_cast<uint8_t>(j);
+    xof_in[33] = static_cast<uint8_t>(i);
+  }
+}
+
+// Samples `cnt` polynomials in NTT domain, each from its own SHAKE128 stream, up to `lanes` of them at once, using 4-way or 8-way
+// SHAKE128. Polynomial number `idx` is sampled into `poly_of(idx)`, from XOF input set by `xof_in_of(idx, xof_in)`, which needn't share
+// anything with others, s.t. polynomials of unrelated matrices can be sampled together. A single leftover polynomial is sampled using
+// the single-lane XOF, as multi-lane permutation would be wasteful for it.
+template<size_t lanes, typename xof_in_fn_t, typename poly_fn_t>
+inline void
+sample_ntt_many_xn(const size_t cnt, xof_in_fn_t&& xof_in_of, poly_fn_t&& poly_of)
+{
+  std::array<std::array<uint8_t, 34>, lanes> xof_in{};
+
+  for (size_t beg = 0; beg < cnt; beg += lanes) {
+    const size_t lane_cnt = std::min(lanes, cnt - beg);
+
+    if (lane_cnt == 1) {
+      xof_in_of(beg, std::span(xof_in[0]));
+
+      shake128::shake128_t hasher;
+      hasher.absorb(xof_in[0]);
+      hasher.finalize();
+
+      sample_ntt(hasher, poly_of(beg));
+      continue;
+    }
+
+    // Unused lanes sample a copy of the first polynomial of this batch, into a scratch polynomial, which is thrown away.
+    std::array<int16_t, ml_kem_ntt::N> scratch{};
+
+    std::array<std::span<const uint8_t>, lanes> ins{};
+    std::array<std::span<int16_t>, lanes> polys{};
+
+    for (size_t j = 0; j < lanes; j++) {
+      const size_t idx = beg + ((j < lane_cnt) ? j : 0);
+      xof_in_of(idx, std::span(xof_in[j]));
+
+      ins[j] = xof_in[j];
+      polys[j] = (j < lane_cnt) ? std::span<int16_t>(poly_of(idx)) : std::span<int16_t>(scratch);
     }
+
+    ml_kem_keccak::shake_xn_t<lanes, shake128::RATE / std::numeric_limits<uint8_t>::digits> hasher;
+    hasher.absorb(ins);
+    hasher.finalize();
+
+    sample_ntt(hasher, polys);
   }
 }
 
+// Samples `dst.size() / N` consecutive entries ( in row-major order ) of public matrix A ( or its transpose ), starting at entry
+// `first`, up to `lanes` entries at once, using 4-way or 8-way SHAKE128. A single leftover entry is sampled using the single-lane XOF,
+// as multi-lane permutation would be wasteful for it.
+template<size_t lanes, size_t k, bool transpose>
+inline void
+generate_matrix_entries_xn(std::span<int16_t> dst, std::span<const uint8_t, 32> rho, const size_t first)
+{
+  const auto xof_in_of = [&](const size_t idx, std::span<uint8_t, 34> xof_in) {
+    std::copy(rho.begin(), rho.end(), xof_in.begin());
+    set_matrix_xof_nonces<transpose>(xof_in, (first + idx) / k, (first + idx) % k);
+  };
+  const auto poly_of = [&](const size_t idx) { return dst.subspan(idx * ml_kem_ntt::N).template first<ml_kem_ntt::N>(); };
+
+  sample_ntt_many_xn<lanes>(dst.size() / ml_kem_ntt::N, xof_in_of, poly_of);
+}
+
+// Generate public matrix A, same as `generate_matrix` does, but sampling up to `lanes` entries at once, using 4-way or 8-way
+// SHAKE128. With 8 lanes, all entries are sampled in one pass for k = 2 and in two passes for k = 3, 4. With 4 lanes, it takes one,
+// three and four passes, respectively. A single leftover entry ( the tail, when k = 3 ) is sampled using the single-lane XOF.
+template<size_t lanes, size_t k, bool transpose>
+inline void
+generate_matrix_xn(std::span<int16_t, k * k * ml_kem_ntt::N> mat, std::span<const uint8_t, 32> rho)
+{
+  generate_matrix_entries_xn<lanes, k, transpose>(mat, rho, 0);
+}
+
 // Generate public matrix A ( consists of degree-255 polynomials ) in NTT domain, by sampling from a XOF ( read SHAKE128 ),
-// which is seeded with 32 -bytes key and two nonces ( each of 1 -byte ).
+// which is seeded with 32 -bytes key and two nonces ( each of 1 -byte ). Coefficients are canonical, held in signed 16 -bit integers.
 //
 // See step (3-7) of algorithm 13 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
 template<size_t k, bool transpose>
 constexpr void
-generate_matrix(std::span<ml_kem_field::zq_t, k * k * ml_kem_ntt::N> mat, std::span<const uint8_t, 32> rho)
+generate_matrix(std::span<int16_t, k * k * ml_kem_ntt::N> mat, std::span<const uint8_t, 32> rho)
   requires(ml_kem_params::check_k(k))
 {
+#if ML_KEM_X86_SIMD && !ML_KEM_LOW_STACK
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      generate_matrix_xn<ml_kem_keccak::avx512::LANES, k, transpose>(mat, rho);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      generate_matrix_xn<ml_kem_keccak::avx2::LANES, k, transpose>(mat, rho);
+      return;
+    }
+  }
+#endif
+
   std::array<uint8_t, rho.size() + 2> xof_in{};
   std::copy(rho.begin(), rho.end(), xof_in.begin());
 
@@ -65,24 +316,48 @@ generate_matrix(std::span<ml_kem_field::zq_t, k * k * ml_kem_ntt::N> mat, std::s
     for (size_t j = 0; j < k; j++) {
       const size_t off = (i * k + j) * ml_kem_ntt::N;
 
-      if constexpr (transpose) {
-        xof_in[32] = static_cast<uint8_t>(i);
-        xof_in[33] = static_cast<uint8_t>(j);
-      } else {
-        xof_in[32] = static_cast<uint8_t>(j);
-        xof_in[33] = static_cast<uint8_t>(i);
-      }
+      set_matrix_xof_nonces<transpose>(xof_in, i, j);
 
       shake128::shake128_t hasher;
       hasher.absorb(xof_in);
       hasher.finalize();
 
-      using poly_t = std::span<ml_kem_field::zq_t, mat.size() / (k * k)>;
+      using poly_t = std::span<int16_t, mat.size() / (k * k)>;
       sample_ntt(hasher, poly_t(mat.subspan(off, ml_kem_ntt::N)));
     }
   }
 }
 
+// Generate row i of public matrix A ( or its transpose ), i.e. k entries, same as `generate_matrix` would place at offset (i * k * 256).
+// On AVX2 capable CPUs, whole row is sampled in a single pass of 4-way SHAKE128, which is preferred over the 8-way one, even on AVX-512
+// capable CPUs, as a row has at most 4 entries. With `ML_KEM_LOW_STACK`, single-lane SHAKE128 is always used.
+template<size_t k, bool transpose>
+constexpr void
+generate_matrix_row(std::span<int16_t, k * ml_kem_ntt::N> row, std::span<const uint8_t, 32> rho, const size_t i)
+  requires(ml_kem_params::check_k(k))
+{
+#if ML_KEM_X86_SIMD && !ML_KEM_LOW_STACK
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    generate_matrix_entries_xn<ml_kem_keccak::avx2::LANES, k, transpose>(row, rho, i * k);
+    return;
+  }
+#endif
+
+  std::array<uint8_t, rho.size() + 2> xof_in{};
+  std::copy(rho.begin(), rho.end(), xof_in.begin());
+
+  for (size_t j = 0; j < k; j++) {
+    set_matrix_xof_nonces<transpose>(xof_in, i, j);
+
+    shake128::shake128_t hasher;
+    hasher.absorb(xof_in);
+    hasher.finalize();
+
+    using poly_t = std::span<int16_t, ml_kem_ntt::N>;
+    sample_ntt(hasher, poly_t(row.subspan(j * ml_kem_ntt::N, ml_kem_ntt::N)));
+  }
+}
+
 // Centered Binomial Distribution.
 // A degree 255 polynomial deterministically sampled from `64 * eta` -bytes output of a pseudorandom function ( PRF ).
 //
@@ -136,11 +411,71 @@ sample_poly_cbd(std::span<const uint8_t, 64 * eta> prf, std::span<ml_kem_field::
   }
 }
 
+// Same as above, but sampling a polynomial with signed 16 -bit coefficients, each ∈ [-η, η], which are consumed by NTT as they are,
+// without any modular reduction. When executing CPU supports AVX2, a vectorized kernel is used.
+template<size_t eta>
+constexpr void
+sample_poly_cbd(std::span<const uint8_t, 64 * eta> prf, std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(ml_kem_params::check_eta(eta))
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    if constexpr (eta == 2) {
+      avx2::cbd2(prf, poly);
+    } else {
+      avx2::cbd3(prf, poly);
+    }
+    return;
+  }
+#endif
+
+  if constexpr (eta == 2) {
+    constexpr size_t till = 64 * eta;
+    constexpr uint8_t mask8 = 0b01010101;
+    constexpr uint8_t mask2 = 0b11;
+
+    for (size_t i = 0; i < till; i++) {
+      const size_t poff = i << 1;
+      const uint8_t word = prf[i];
+
+      const uint8_t t0 = (word >> 0) & mask8;
+      const uint8_t t1 = (word >> 1) & mask8;
+      const uint8_t t2 = t0 + t1;
+
+      poly[poff + 0] = static_cast<int16_t>(((t2 >> 0) & mask2) - ((t2 >> 2) & mask2));
+      poly[poff + 1] = static_cast<int16_t>(((t2 >> 4) & mask2) - ((t2 >> 6) & mask2));
+    }
+  } else {
+    constexpr size_t till = 64;
+    constexpr uint32_t mask24 = 0b001001001001001001001001U;
+    constexpr uint32_t mask3 = 0b111U;
+
+    for (size_t i = 0; i < till; i++) {
+      const size_t boff = i * 3;
+      const size_t poff = i << 2;
+
+      const uint32_t word = (static_cast<uint32_t>(prf[boff + 2]) << 16) | (static_cast<uint32_t>(prf[boff + 1]) << 8) | static_cast<uint32_t>(prf[boff + 0]);
+
+      const uint32_t t0 = (word >> 0) & mask24;
+      const uint32_t t1 = (word >> 1) & mask24;
+      const uint32_t t2 = (word >> 2) & mask24;
+      const uint32_t t3 = t0 + t1 + t2;
+
+      poly[poff + 0] = static_cast<int16_t>(static_cast<int32_t>((t3 >> 0) & mask3) - static_cast<int32_t>((t3 >> 3) & mask3));
+      poly[poff + 1] = static_cast<int16_t>(static_cast<int32_t>((t3 >> 6) & mask3) - static_cast<int32_t>((t3 >> 9) & mask3));
+      poly[poff + 2] = static_cast<int16_t>(static_cast<int32_t>((t3 >> 12) & mask3) - static_cast<int32_t>((t3 >> 15) & mask3));
+      poly[poff + 3] = static_cast<int16_t>(static_cast<int32_t>((t3 >> 18) & mask3) - static_cast<int32_t>((t3 >> 21) & mask3));
+    }
+  }
+}
+
 // Sample a polynomial vector from Bη, following step (8-11) of algorithm 13 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203.
+// Coefficients are held in signed 16 -bit integers, each ∈ [-η, η]. Note, k + 1 polynomials are sampled at once, when error vector e1
+// and error polynomial e2 of K-PKE encryption are held next to each other.
 template<size_t k, size_t eta>
 constexpr void
-generate_vector(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec, std::span<const uint8_t, 32> sigma, const uint8_t nonce)
-  requires((k == 1) || ml_kem_params::check_k(k))
+generate_vector(std::span<int16_t, k * ml_kem_ntt::N> vec, std::span<const uint8_t, 32> sigma, const uint8_t nonce)
+  requires((k == 1) || ml_kem_params::check_k(k) || ml_kem_params::check_k(k - 1))
 {
   std::array<uint8_t, 64 * eta> prf_out{};
   std::array<uint8_t, sigma.size() + 1> prf_in{};
@@ -156,9 +491,117 @@ generate_vector(std::span<ml_kem_field::zq_t, k * ml_kem_ntt::N> vec, std::span<
     hasher.finalize();
     hasher.squeeze(prf_out);
 
-    using poly_t = std::span<ml_kem_field::zq_t, vec.size() / k>;
+    using poly_t = std::span<int16_t, vec.size() / k>;
     ml_kem_utils::sample_poly_cbd<eta>(prf_out, poly_t(vec.subspan(off, ml_kem_ntt::N)));
   }
 }
 
+// Computes `cnt` PRF invocations, each producing `prf_out_len` -bytes of SHAKE256 output, up to `lanes` of them at once, using 4-way or
+// 8-way SHAKE256. Invocation number `idx` gets its input set by `prf_in_of(idx, prf_in)` and its output is handed over to
+// `sample(idx, prf_out)`, s.t. noise of unrelated operations, using different seeds, can be sampled together. A single leftover PRF
+// invocation uses single-lane SHAKE256. All PRF outputs are zeroized before returning.
+template<size_t lanes, size_t prf_out_len, typename prf_in_fn_t, typename sample_fn_t>
+inline void
+sample_cbd_many_xn(const size_t cnt, prf_in_fn_t&& prf_in_of, sample_fn_t&& sample)
+{
+  std::array<std::array<uint8_t, prf_out_len>, lanes> prf_out{};
+  std::array<std::array<uint8_t, 33>, lanes> prf_in{};
+
+  for (size_t beg = 0; beg < cnt; beg += lanes) {
+    const size_t lane_cnt = std::min(lanes, cnt - beg);
+
+    if (lane_cnt == 1) {
+      prf_in_of(beg, std::span(prf_in[0]));
+
+      shake256::shake256_t hasher;
+      hasher.absorb(prf_in[0]);
+      hasher.finalize();
+      hasher.squeeze(prf_out[0]);
+
+      sample(beg, std::span<const uint8_t, prf_out_len>(prf_out[0]));
+      continue;
+    }
+
+    // Unused lanes compute a copy of the first PRF invocation of this batch, whose output is thrown away.
+    std::array<std::span<const uint8_t>, lanes> ins{};
+    std::array<std::span<uint8_t>, lanes> outs{};
+
+    for (size_t j = 0; j < lanes; j++) {
+      prf_in_of(beg + ((j < lane_cnt) ? j : 0), std::span(prf_in[j]));
+
+      ins[j] = prf_in[j];
+      outs[j] = prf_out[j];
+    }
+
+    ml_kem_keccak::shake_xn_t<lanes, shake256::RATE / std::numeric_limits<uint8_t>::digits> hasher;
+    hasher.absorb(ins);
+    hasher.finalize();
+    hasher.squeeze(outs);
+
+    for (size_t j = 0; j < lane_cnt; j++) {
+      sample(beg + j, std::span<const uint8_t, prf_out_len>(prf_out[j]));
+    }
+  }
+
+  ml_kem_utils::secure_zeroize(prf_in);
+  ml_kem_utils::secure_zeroize(prf_out);
+}
+
+// Sample two polynomial vectors, same as `generate_vectors` does, but computing up to `lanes` PRF invocations at once, using 4-way or
+// 8-way SHAKE256. Each lane squeezes as many bytes as the larger of η1, η2 requires, of which `sample_poly_cbd` consumes a prefix, as
+// SHAKE256 output of shorter length is a prefix of the longer one. A single leftover PRF invocation uses single-lane SHAKE256.
+template<size_t lanes, size_t k1, size_t eta1, size_t k2, size_t eta2>
+inline void
+generate_vectors_xn(std::span<int16_t, k1 * ml_kem_ntt::N> vec1,
+                    std::span<int16_t, k2 * ml_kem_ntt::N> vec2,
+                    std::span<const uint8_t, 32> sigma,
+                    const uint8_t nonce)
+{
+  constexpr size_t prf_out_len = 64 * std::max(eta1, eta2);
+
+  const auto prf_in_of = [&](const size_t idx, std::span<uint8_t, 33> prf_in) {
+    std::copy(sigma.begin(), sigma.end(), prf_in.begin());
+    prf_in[32] = static_cast<uint8_t>(nonce + idx);
+  };
+
+  // Samples polynomial number `idx`, from respective vector, using given PRF output.
+  const auto sample = [&](const size_t idx, std::span<const uint8_t, prf_out_len> prf_out) {
+    if (idx < k1) {
+      sample_poly_cbd<eta1>(prf_out.template first<64 * eta1>(), vec1.subspan(idx * ml_kem_ntt::N).template first<ml_kem_ntt::N>());
+    } else {
+      sample_poly_cbd<eta2>(prf_out.template first<64 * eta2>(), vec2.subspan((idx - k1) * ml_kem_ntt::N).template first<ml_kem_ntt::N>());
+    }
+  };
+
+  sample_cbd_many_xn<lanes, prf_out_len>(k1 + k2, prf_in_of, sample);
+}
+
+// Sample `k1` polynomials from Bη1 into `vec1`, followed by `k2` polynomials from Bη2 into `vec2`, using consecutive PRF nonces,
+// starting at `nonce`. Produces exactly what two consecutive calls to `generate_vector` would produce, while all PRF invocations
+// of an operation are computed together, using multi-lane SHAKE256, when executing CPU supports it and `ML_KEM_LOW_STACK` isn't set.
+template<size_t k1, size_t eta1, size_t k2, size_t eta2>
+constexpr void
+generate_vectors(std::span<int16_t, k1 * ml_kem_ntt::N> vec1,
+                 std::span<int16_t, k2 * ml_kem_ntt::N> vec2,
+                 std::span<const uint8_t, 32> sigma,
+                 const uint8_t nonce)
+  requires(ml_kem_params::check_k(k1) && ml_kem_params::check_eta(eta1) && ml_kem_params::check_eta(eta2))
+{
+#if ML_KEM_X86_SIMD && !ML_KEM_LOW_STACK
+  if (!std::is_constant_evaluated()) {
+    if (ml_kem_cpu::has_avx512()) {
+      generate_vectors_xn<ml_kem_keccak::avx512::LANES, k1, eta1, k2, eta2>(vec1, vec2, sigma, nonce);
+      return;
+    }
+    if (ml_kem_cpu::has_avx2()) {
+      generate_vectors_xn<ml_kem_keccak::avx2::LANES, k1, eta1, k2, eta2>(vec1, vec2, sigma, nonce);
+      return;
+    }
+  }
+#endif
+
+  generate_vector<k1, eta1>(vec1, sigma, nonce);
+  generate_vector<k2, eta2>(vec2, sigma, static_cast<uint8_t>(nonce + k1));
+}
+
 }
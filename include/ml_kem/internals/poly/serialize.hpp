@@ -1,10 +1,16 @@
 #pragma once
+#include "ml_kem/internals/arch/avx2/serialize.hpp"
 #include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/unreduced.hpp"
 #include "ml_kem/internals/poly/ntt.hpp"
+#include "ml_kem/internals/utility/cpu_features.hpp"
 #include "ml_kem/internals/utility/params.hpp"
+#include "ml_kem/internals/utility/utils.hpp"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <type_traits>
 
 namespace ml_kem_utils {
 
@@ -281,4 +287,92 @@ decode(std::span<const uint8_t, 32 * l> arr, std::span<ml_kem_field::zq_t, ml_ke
   }
 }
 
+// Same as `encode` above, but for a polynomial with signed 16 -bit coefficients, each ∈ [0, 2^l) when l < 12, while they may be lazily
+// reduced when l = 12. Coefficients are fully reduced and converted to `zq_t` form, at this serialization boundary. When executing CPU
+// supports AVX2, a vectorized kernel, producing same bytes, is used.
+template<size_t l>
+constexpr void
+encode(std::span<const int16_t, ml_kem_ntt::N> poly, std::span<uint8_t, 32 * l> arr)
+  requires(ml_kem_params::check_l(l))
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    avx2::encode<l>(poly, arr);
+    return;
+  }
+#endif
+
+  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> tmp{};
+  for (size_t i = 0; i < poly.size(); i++) {
+    tmp[i] = ml_kem_field::zq_t(static_cast<uint16_t>(ml_kem_field::to_canonical(poly[i])));
+  }
+
+  encode<l>(tmp, arr);
+  ml_kem_utils::secure_zeroize(tmp);
+}
+
+// Same as `decode` above, but decoding into a polynomial with signed 16 -bit coefficients, each ∈ [0, 2^l), which are also
+// canonical when l = 12. When executing CPU supports AVX2, a vectorized kernel, producing same coefficients, is used.
+template<size_t l>
+constexpr void
+decode(std::span<const uint8_t, 32 * l> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(ml_kem_params::check_l(l))
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    avx2::decode<l>(arr, poly);
+    return;
+  }
+#endif
+
+  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> tmp{};
+  decode<l>(arr, tmp);
+
+  for (size_t i = 0; i < poly.size(); i++) {
+    poly[i] = static_cast<int16_t>(tmp[i].raw());
+  }
+
+  ml_kem_utils::secure_zeroize(tmp);
+}
+
+// Same as `decode<12>` above, decoding into a polynomial with canonical signed 16 -bit coefficients, but also checking whether any of the
+// decoded 12 -bit coefficients is ≥ q, in the same pass, and in constant-time. Returns truth value (0xffffffff) if at least one of them
+// is, otherwise it returns false value (0x00000000). When executing CPU supports AVX2, a vectorized kernel is used.
+//
+// This is the modulus check, described in point (2) of section 7.2 of ML-KEM specification https://doi.org/10.6028/NIST.FIPS.203, as
+// ByteEncode12(ByteDecode12(x)) = x holds iff none of the decoded coefficients is ≥ q.
+template<size_t l>
+constexpr uint32_t
+decode_checked(std::span<const uint8_t, 32 * l> arr, std::span<int16_t, ml_kem_ntt::N> poly)
+  requires(l == 12)
+{
+#if ML_KEM_X86_SIMD
+  if (!std::is_constant_evaluated() && ml_kem_cpu::has_avx2()) {
+    const uint32_t non_canonical = avx2::decode_checked(arr, poly);
+    return ~subtle::ct_eq<uint32_t, uint32_t>(non_canonical, 0U);
+  }
+#endif
+
+  constexpr size_t itr_cnt = ml_kem_ntt::N >> 1;
+  constexpr uint8_t mask4 = 0b1111;
+
+  uint32_t non_canonical = 0;
+
+  for (size_t i = 0; i < itr_cnt; i++) {
+    const size_t poff = i << 1;
+    const size_t boff = i * 3;
+
+    const auto t0 = (static_cast<uint32_t>(arr[boff + 1] & mask4) << 8) | static_cast<uint32_t>(arr[boff + 0]);
+    const auto t1 = (static_cast<uint32_t>(arr[boff + 2]) << 4) | static_cast<uint32_t>(arr[boff + 1] >> 4);
+
+    // (q - 1 - t) underflows, setting the most significant bit, iff t ≥ q.
+    non_canonical |= ((ml_kem_field::Q - 1U - t0) | (ml_kem_field::Q - 1U - t1)) >> 31;
+
+    poly[poff + 0] = static_cast<int16_t>(ml_kem_field::zq_t::from_non_reduced(t0).raw());
+    poly[poff + 1] = static_cast<int16_t>(ml_kem_field::zq_t::from_non_reduced(t1).raw());
+  }
+
+  return -non_canonical;
+}
+
 }
@@ -0,0 +1,53 @@
+#pragma once
+
+// Vectorized kernels are only compiled for x86_64 targets, using GCC/ Clang function-level target attributes, so that the library
+// can still be built without any `-m` flag and the best available instruction set is picked at runtime. Define `ML_KEM_DISABLE_SIMD`
+// to force the portable implementation everywhere.
+#if !defined(ML_KEM_DISABLE_SIMD) && (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+#define ML_KEM_X86_SIMD 1
+#else
+#define ML_KEM_X86_SIMD 0
+#endif
+
+#if ML_KEM_X86_SIMD
+#define ML_KEM_TARGET_AVX2 __attribute__((target("avx2")))
+#define ML_KEM_TARGET_AVX512 __attribute__((target("avx2,avx512f,avx512bw")))
+#endif
+
+// Runtime CPU feature detection, used for dispatching to the fastest available implementation of hot kernels.
+namespace ml_kem_cpu {
+
+// Returns true if executing CPU supports AVX2 instruction set extension. Detection happens only once, on first call.
+inline bool
+has_avx2()
+{
+#if ML_KEM_X86_SIMD
+  static const bool flag = []() -> bool {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2") != 0;
+  }();
+
+  return flag;
+#else
+  return false;
+#endif
+}
+
+// Returns true if executing CPU supports AVX-512 Foundation and Byte/ Word instruction set extensions. Detection happens only once,
+// on first call.
+inline bool
+has_avx512()
+{
+#if ML_KEM_X86_SIMD
+  static const bool flag = []() -> bool {
+    __builtin_cpu_init();
+    return (__builtin_cpu_supports("avx512f") != 0) && (__builtin_cpu_supports("avx512bw") != 0);
+  }();
+
+  return flag;
+#else
+  return false;
+#endif
+}
+
+}
@@ -1,11 +1,22 @@
 #pragma once
 #include "ml_kem/internals/utility/force_inline.hpp"
 #include "subtle.hpp"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <span>
 #include <type_traits>
+#include <utility>
+
+// Define `ML_KEM_LOW_STACK` as 1, for keeping peak stack usage of key generation, encapsulation and decapsulation below 4KB, for every
+// parameter set, say when running inside fibers or stackful coroutines with small stacks. It implies `ML_KEM_STREAM_MATRIX`, samples
+// matrix A and noise vectors using single-lane SHAKE128/ SHAKE256, as multi-lane Keccak states and their buffers alone take 4KB to 16KB
+// of stack, and makes routines which are not supplied a workspace allocate it on heap.
+#ifndef ML_KEM_LOW_STACK
+#define ML_KEM_LOW_STACK 0
+#endif
 
 namespace ml_kem_utils {
 
@@ -24,6 +35,43 @@ secure_zeroize(std::array<T, N>& arr)
   }
 }
 
+// Same as above, but zeroizing memory viewed by a std::span, say a prefix of a larger buffer.
+template<typename T, size_t N>
+forceinline constexpr void
+secure_zeroize(std::span<T, N> span)
+{
+  std::fill(span.begin(), span.end(), T{});
+  if (!std::is_constant_evaluated()) {
+    asm volatile("" : : "r"(span.data()) : "memory"); // NOLINT(hicpp-no-assembler)
+  }
+}
+
+// Invokes `fn` with a value-initialized object of type T, allocated on heap, returning whatever `fn` returns.
+template<typename T, typename fn_t>
+inline decltype(auto)
+with_heap_temporary(fn_t&& fn)
+{
+  auto obj = std::make_unique<T>();
+  return fn(*obj);
+}
+
+// Invokes `fn` with a value-initialized object of type T, used for holding large temporaries of routines which are not supplied a
+// workspace, returning whatever `fn` returns. The object lives on stack, unless `ML_KEM_LOW_STACK` is set, in which case it's allocated
+// on heap, s.t. it never adds to the stack footprint. During constant evaluation, it always lives on stack.
+template<typename T, typename fn_t>
+constexpr decltype(auto)
+with_temporary(fn_t&& fn)
+{
+#if ML_KEM_LOW_STACK
+  if (!std::is_constant_evaluated()) {
+    return with_heap_temporary<T>(std::forward<fn_t>(fn));
+  }
+#endif
+
+  T obj{};
+  return fn(obj);
+}
+
 // Given two byte arrays of equal length, this routine can be used for comparing them in constant-time,
 // producing truth value (0xffffffff) in case of equality, otherwise it returns false value (0x00000000).
 template<size_t n>
@@ -0,0 +1,79 @@
+#pragma once
+#include "ml_kem/internals/engine.hpp"
+#include "ml_kem/ml_kem_1024.hpp"
+#include <functional>
+#include <future>
+#include <span>
+#include <utility>
+#include <vector>
+
+// Opt-in thread-pool engine for ML-KEM-1024, spreading batched routines of "ml_kem/ml_kem_1024.hpp" over many cores. It needs worker
+// threads, so it's kept apart from the parameter set header, which stays free of any threading dependency. Link against CMake target
+// `ml-kem-engine`, instead of `ml-kem`, for using it.
+namespace ml_kem_1024 {
+
+// Pool of worker threads, spreading batched ML-KEM-1024 routines over many cores, see `ml_kem::engine`. Spans passed to a job must stay
+// alive and must not be modified, till the job is complete.
+using engine = ml_kem::engine;
+
+// Given N seed pairs, this routine computes N ML-KEM-1024 keypairs, same as `keygen_batch` does, on worker threads of the engine.
+// The returned future resolves to true, once all keypairs are computed, or to false, if the spans are not of same length.
+[[nodiscard("Wait on the future, for the job to complete")]] inline std::future<bool>
+keygen_batch(engine& eng, std::span<const seed_pair_t> seeds, std::span<pubkey_t> pubkeys, std::span<seckey_t> seckeys)
+{
+  return eng.keygen<k, eta1>(seeds, pubkeys, seckeys);
+}
+
+// Same as above, but completion is signalled by invoking `done` on a worker thread.
+inline void
+keygen_batch(engine& eng, std::span<const seed_pair_t> seeds, std::span<pubkey_t> pubkeys, std::span<seckey_t> seckeys, std::function<void(bool)> done)
+{
+  eng.keygen<k, eta1>(seeds, pubkeys, seckeys, std::move(done));
+}
+
+// Given N seeds `m` and N ML-KEM-1024 public keys, this routine computes N cipher texts and shared secrets, same as `encapsulate_batch`
+// does, on worker threads of the engine. The returned future resolves to a bitmap, whose bit i is set iff public key i is
+// well-formed, once all items are computed. If the spans are not of same length, it resolves to an empty bitmap.
+[[nodiscard("Wait on the future, for the job to complete")]] inline std::future<std::vector<bool>>
+encapsulate_batch(engine& eng,
+                  std::span<const seed_m_t> ms,
+                  std::span<const pubkey_t> pubkeys,
+                  std::span<cipher_text_t> ciphers,
+                  std::span<shared_secret_t> shared_secrets)
+{
+  return eng.encapsulate<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets);
+}
+
+// Same as above, but completion is signalled by invoking `done` on a worker thread.
+inline void
+encapsulate_batch(engine& eng,
+                  std::span<const seed_m_t> ms,
+                  std::span<const pubkey_t> pubkeys,
+                  std::span<cipher_text_t> ciphers,
+                  std::span<shared_secret_t> shared_secrets,
+                  std::function<void(std::vector<bool>)> done)
+{
+  eng.encapsulate<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets, std::move(done));
+}
+
+// Given a prepared ML-KEM-1024 secret key and N cipher texts, this routine computes N shared secrets, same as `decapsulate_batch`
+// does, on worker threads of the engine. The returned future resolves to true, once all shared secrets are computed, or to false, if
+// the spans are not of same length. The prepared secret key must stay alive, till the job is complete.
+[[nodiscard("Wait on the future, for the job to complete")]] inline std::future<bool>
+decapsulate_batch(engine& eng, const prepared_seckey& seckey, std::span<const cipher_text_t> ciphers, std::span<shared_secret_t> shared_secrets)
+{
+  return eng.decapsulate<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets);
+}
+
+// Same as above, but completion is signalled by invoking `done` on a worker thread.
+inline void
+decapsulate_batch(engine& eng,
+                  const prepared_seckey& seckey,
+                  std::span<const cipher_text_t> ciphers,
+                  std::span<shared_secret_t> shared_secrets,
+                  std::function<void(bool)> done)
+{
+  eng.decapsulate<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets, std::move(done));
+}
+
+}
@@ -1,9 +1,12 @@
 #pragma once
+#include "ml_kem/internals/batch.hpp"
 #include "ml_kem/internals/ml_kem.hpp"
 #include "ml_kem/internals/utility/utils.hpp"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <span>
+#include <vector>
 
 namespace ml_kem_768 {
 
@@ -37,6 +40,13 @@ inline constexpr size_t CIPHER_TEXT_BYTE_LEN = ml_kem_utils::get_kem_cipher_text
 // 32 -bytes ML-KEM-768 shared secret
 inline constexpr size_t SHARED_SECRET_BYTE_LEN = 32;
 
+// Caller-supplied, cache-line aligned workspace, holding all large temporaries of ML-KEM-768 key generation, encapsulation and decapsulation.
+// It can be reused across calls, but must not be used by more than one call at a time.
+using workspace = ml_kem::workspace_t<k>;
+
+// Byte length of ML-KEM-768 workspace.
+inline constexpr size_t WORKSPACE_BYTES = sizeof(workspace);
+
 // Computes a new ML-KEM-768 keypair, given seed `d` and `z`.
 constexpr void
 keygen(std::span<const uint8_t, SEED_D_BYTE_LEN> d,
@@ -47,6 +57,17 @@ keygen(std::span<const uint8_t, SEED_D_BYTE_LEN> d,
   ml_kem::keygen<k, eta1>(d, z, pubkey, seckey);
 }
 
+// Computes a new ML-KEM-768 keypair, given seed `d` and `z`, using caller-supplied workspace.
+constexpr void
+keygen(std::span<const uint8_t, SEED_D_BYTE_LEN> d,
+       std::span<const uint8_t, SEED_Z_BYTE_LEN> z,
+       std::span<uint8_t, PKEY_BYTE_LEN> pubkey,
+       std::span<uint8_t, SKEY_BYTE_LEN> seckey,
+       workspace& ws)
+{
+  ml_kem::keygen<k, eta1>(d, z, pubkey, seckey, ws);
+}
+
 // Given seed `m` and a ML-KEM-768 public key, this routine computes a ML-KEM-768 cipher text and a fixed size shared secret.
 // If, input ML-KEM-768 public key is malformed, encapsulation will fail, returning false.
 [[nodiscard("If public key is malformed, encapsulation fails")]] constexpr bool
@@ -58,6 +79,41 @@ encapsulate(std::span<const uint8_t, SEED_M_BYTE_LEN> m,
   return ml_kem::encapsulate<k, eta1, eta2, du, dv>(m, pubkey, cipher, shared_secret);
 }
 
+// Given seed `m` and a ML-KEM-768 public key, this routine computes a ML-KEM-768 cipher text and a fixed size shared secret, using
+// caller-supplied workspace. If, input ML-KEM-768 public key is malformed, encapsulation will fail, returning false.
+[[nodiscard("If public key is malformed, encapsulation fails")]] constexpr bool
+encapsulate(std::span<const uint8_t, SEED_M_BYTE_LEN> m,
+            std::span<const uint8_t, PKEY_BYTE_LEN> pubkey,
+            std::span<uint8_t, CIPHER_TEXT_BYTE_LEN> cipher,
+            std::span<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret,
+            workspace& ws)
+{
+  return ml_kem::encapsulate<k, eta1, eta2, du, dv>(m, pubkey, cipher, shared_secret, ws);
+}
+
+// ML-KEM-768 public key, validated and expanded once, for encapsulating to it many times. Holds H(ek), decoded vector t and expanded
+// matrix A, in NTT domain.
+using prepared_pubkey = ml_kem::prepared_pubkey_t<k>;
+
+// Given a ML-KEM-768 public key, this routine validates it and prepares it for repeated encapsulation.
+// If, input ML-KEM-768 public key is malformed, preparation fails, returning false.
+[[nodiscard("If public key is malformed, preparation fails")]] constexpr bool
+prepare_pubkey(std::span<const uint8_t, PKEY_BYTE_LEN> pubkey, prepared_pubkey& prepared)
+{
+  return ml_kem::prepare_pubkey<k>(pubkey, prepared);
+}
+
+// Given seed `m` and a prepared ML-KEM-768 public key, this routine computes a ML-KEM-768 cipher text and a fixed size shared secret,
+// same as `encapsulate` does given the byte serialized public key, while skipping all work that depends on the public key only.
+constexpr void
+encapsulate(std::span<const uint8_t, SEED_M_BYTE_LEN> m,
+            const prepared_pubkey& pubkey,
+            std::span<uint8_t, CIPHER_TEXT_BYTE_LEN> cipher,
+            std::span<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret)
+{
+  ml_kem::encapsulate<k, eta1, eta2, du, dv>(m, pubkey, cipher, shared_secret);
+}
+
 // Given a ML-KEM-768 secret key and a cipher text, this routine computes a fixed size shared secret.
 constexpr void
 decapsulate(std::span<const uint8_t, SKEY_BYTE_LEN> seckey, std::span<const uint8_t, CIPHER_TEXT_BYTE_LEN> cipher, std::span<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret)
@@ -65,4 +121,147 @@ decapsulate(std::span<const uint8_t, SKEY_BYTE_LEN> seckey, std::span<const uint
   ml_kem::decapsulate<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret);
 }
 
+// Given a ML-KEM-768 secret key and a cipher text, this routine computes a fixed size shared secret, using caller-supplied workspace.
+constexpr void
+decapsulate(std::span<const uint8_t, SKEY_BYTE_LEN> seckey,
+            std::span<const uint8_t, CIPHER_TEXT_BYTE_LEN> cipher,
+            std::span<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret,
+            workspace& ws)
+{
+  ml_kem::decapsulate<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret, ws);
+}
+
+// ML-KEM-768 secret key, validated and decoded once, for decapsulating many times. Holds decoded vector s, embedded public key, already
+// prepared for re-encryption, and implicit rejection value z. As it holds secret material, it should be zeroized once no longer needed.
+using prepared_seckey = ml_kem::prepared_seckey_t<k>;
+
+// Given a ML-KEM-768 secret key, this routine validates it, using the hash check of FIPS 203 section 7.3, and prepares it for repeated
+// decapsulation. If, input ML-KEM-768 secret key is malformed, preparation fails, returning false.
+[[nodiscard("If secret key is malformed, preparation fails")]] constexpr bool
+prepare_seckey(std::span<const uint8_t, SKEY_BYTE_LEN> seckey, prepared_seckey& prepared)
+{
+  return ml_kem::prepare_seckey<k>(seckey, prepared);
+}
+
+// Given a prepared ML-KEM-768 secret key and a cipher text, this routine computes a fixed size shared secret, same as `decapsulate`
+// does given the byte serialized secret key, while skipping all work that depends on the secret key only.
+constexpr void
+decapsulate(const prepared_seckey& seckey, std::span<const uint8_t, CIPHER_TEXT_BYTE_LEN> cipher, std::span<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret)
+{
+  ml_kem::decapsulate<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret);
+}
+
+// Pair of 32 -bytes seeds `d` and `z`, from which a ML-KEM-768 keypair is generated, by batched key generation.
+using seed_pair_t = ml_kem::seed_pair_t;
+
+// Byte serialized ML-KEM-768 public key and secret key, as produced by batched key generation.
+using pubkey_t = std::array<uint8_t, PKEY_BYTE_LEN>;
+using seckey_t = std::array<uint8_t, SKEY_BYTE_LEN>;
+
+// Seed `m`, ML-KEM-768 cipher text and shared secret, as consumed and produced by batched encapsulation.
+using seed_m_t = std::array<uint8_t, SEED_M_BYTE_LEN>;
+using cipher_text_t = std::array<uint8_t, CIPHER_TEXT_BYTE_LEN>;
+using shared_secret_t = std::array<uint8_t, SHARED_SECRET_BYTE_LEN>;
+
+// Caller-supplied workspace of batched ML-KEM-768 routines, holding a workspace for each of the items processed together. As it is
+// large, it's better to allocate it on heap. It can be reused across calls, but must not be used by more than one call at a time.
+using batch_workspace = ml_kem::batch_workspace_t<k>;
+
+// Given N seed pairs, this routine computes N ML-KEM-768 keypairs, each byte-identical to what `keygen` computes for respective seed
+// pair, while hashing and sampling of up to 8 keypairs is done together, using multi-lane Keccak, using caller-supplied batch workspace.
+// If the spans are not of same length, it fails, returning false.
+[[nodiscard("If spans are not of same length, batched key generation fails")]] constexpr bool
+keygen_batch(std::span<const seed_pair_t> seeds, std::span<pubkey_t> pubkeys, std::span<seckey_t> seckeys, batch_workspace& ws)
+{
+  return ml_kem::keygen_batch<k, eta1>(seeds, pubkeys, seckeys, ws);
+}
+
+// Given N seed pairs, this routine computes N ML-KEM-768 keypairs, same as `keygen_batch` above does, using a batch workspace, which is
+// allocated on heap. If the spans are not of same length, it fails, returning false.
+[[nodiscard("If spans are not of same length, batched key generation fails")]] inline bool
+keygen_batch(std::span<const seed_pair_t> seeds, std::span<pubkey_t> pubkeys, std::span<seckey_t> seckeys)
+{
+  return ml_kem::keygen_batch<k, eta1>(seeds, pubkeys, seckeys);
+}
+
+// Given N seeds `m` and N ML-KEM-768 public keys, this routine computes N cipher texts and shared secrets, each byte-identical to what
+// `encapsulate` computes for respective seed and public key, while hashing and sampling of up to 8 items is done together, using
+// multi-lane Keccak, using caller-supplied batch workspace. Returns a bitmap, whose bit i is set iff public key i is well-formed, while
+// outputs of items with malformed public key are left untouched. If the spans are not of same length, an empty bitmap is returned.
+[[nodiscard("Bitmap tells which of the public keys are malformed")]] constexpr std::vector<bool>
+encapsulate_batch(std::span<const seed_m_t> ms,
+                  std::span<const pubkey_t> pubkeys,
+                  std::span<cipher_text_t> ciphers,
+                  std::span<shared_secret_t> shared_secrets,
+                  batch_workspace& ws)
+{
+  return ml_kem::encapsulate_batch<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets, ws);
+}
+
+// Given N seeds `m` and N ML-KEM-768 public keys, this routine computes N cipher texts and shared secrets, same as `encapsulate_batch`
+// above does, using a batch workspace, which is allocated on heap.
+[[nodiscard("Bitmap tells which of the public keys are malformed")]] inline std::vector<bool>
+encapsulate_batch(std::span<const seed_m_t> ms, std::span<const pubkey_t> pubkeys, std::span<cipher_text_t> ciphers, std::span<shared_secret_t> shared_secrets)
+{
+  return ml_kem::encapsulate_batch<k, eta1, eta2, du, dv>(ms, pubkeys, ciphers, shared_secrets);
+}
+
+// Given ML-KEM-768 secret key and N cipher texts, this routine computes N shared secrets, each byte-identical to what `decapsulate`
+// computes for respective cipher text, while the secret key is decoded only once and hashing and sampling of up to 8 re-encryptions is
+// done together, using multi-lane Keccak, using caller-supplied batch workspace. If the spans are not of same length, it fails, returning
+// false.
+[[nodiscard("If spans are not of same length, batched decapsulation fails")]] constexpr bool
+decapsulate_batch(std::span<const uint8_t, SKEY_BYTE_LEN> seckey,
+                  std::span<const cipher_text_t> ciphers,
+                  std::span<shared_secret_t> shared_secrets,
+                  batch_workspace& ws)
+{
+  return ml_kem::decapsulate_batch<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets, ws);
+}
+
+// Same as above, but decapsulating N cipher texts using a prepared ML-KEM-768 secret key.
+[[nodiscard("If spans are not of same length, batched decapsulation fails")]] constexpr bool
+decapsulate_batch(const prepared_seckey& seckey, std::span<const cipher_text_t> ciphers, std::span<shared_secret_t> shared_secrets, batch_workspace& ws)
+{
+  return ml_kem::decapsulate_batch<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets, ws);
+}
+
+// Given ML-KEM-768 secret key and N cipher texts, this routine computes N shared secrets, same as `decapsulate_batch` above does, using a
+// batch workspace, which is allocated on heap. If the spans are not of same length, it fails, returning false.
+[[nodiscard("If spans are not of same length, batched decapsulation fails")]] inline bool
+decapsulate_batch(std::span<const uint8_t, SKEY_BYTE_LEN> seckey, std::span<const cipher_text_t> ciphers, std::span<shared_secret_t> shared_secrets)
+{
+  return ml_kem::decapsulate_batch<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets);
+}
+
+// Same as above, but decapsulating N cipher texts using a prepared ML-KEM-768 secret key.
+[[nodiscard("If spans are not of same length, batched decapsulation fails")]] inline bool
+decapsulate_batch(const prepared_seckey& seckey, std::span<const cipher_text_t> ciphers, std::span<shared_secret_t> shared_secrets)
+{
+  return ml_kem::decapsulate_batch<k, eta1, eta2, du, dv>(seckey, ciphers, shared_secrets);
+}
+
+// Given N prepared ML-KEM-768 secret keys and a cipher text, this routine computes N candidate shared secrets, i-th one being
+// byte-identical to what `decapsulate` computes for the cipher text under i-th secret key, while the cipher text is decoded only once and
+// hashing and sampling of up to 8 keys is done together, using multi-lane Keccak, using caller-supplied batch workspace. It's meant for
+// trying a cipher text against a set of keys, without branching on which key is the right one. If the spans are not of same length, it
+// fails, returning false.
+[[nodiscard("If spans are not of same length, trial decapsulation fails")]] constexpr bool
+decapsulate_many_keys(std::span<const prepared_seckey> seckeys,
+                      std::span<const uint8_t, CIPHER_TEXT_BYTE_LEN> cipher,
+                      std::span<shared_secret_t> shared_secrets,
+                      batch_workspace& ws)
+{
+  return ml_kem::decapsulate_many_keys<k, eta1, eta2, du, dv>(seckeys, cipher, shared_secrets, ws);
+}
+
+// Given N prepared ML-KEM-768 secret keys and a cipher text, this routine computes N candidate shared secrets, same as
+// `decapsulate_many_keys` above does, using a batch workspace, which is allocated on heap. If the spans are not of same length, it fails,
+// returning false.
+[[nodiscard("If spans are not of same length, trial decapsulation fails")]] inline bool
+decapsulate_many_keys(std::span<const prepared_seckey> seckeys, std::span<const uint8_t, CIPHER_TEXT_BYTE_LEN> cipher, std::span<shared_secret_t> shared_secrets)
+{
+  return ml_kem::decapsulate_many_keys<k, eta1, eta2, du, dv>(seckeys, cipher, shared_secrets);
+}
+
 }
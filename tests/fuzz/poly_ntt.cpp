@@ -6,7 +6,8 @@
 #include <span>
 
 // Fuzzer for NTT/INTT round-trip consistency.
-// Ensures that INTT(NTT(poly)) == poly for any arbitrary polynomial.
+// Ensures that INTT(NTT(poly)) == poly for any arbitrary polynomial, and that the runtime dispatched NTT
+// is bit-identical to the portable reference implementation.
 extern "C" int
 LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 {
@@ -27,6 +28,15 @@ LLVMFuzzerTestOneInput(const uint8_t* data, size_t size)
 
   // Round-trip: NTT followed by INTT
   ml_kem_ntt::ntt(poly_work);
+
+  // Property: Dispatched NTT must match reference NTT
+  auto poly_ref = poly_orig;
+  ml_kem_ntt::scalar::ntt(poly_ref);
+
+  if (poly_work != poly_ref) {
+    __builtin_trap();
+  }
+
   ml_kem_ntt::intt(poly_work);
 
   // Property: Result must be identical to original
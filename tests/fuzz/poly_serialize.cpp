@@ -1,13 +1,16 @@
 #include "ml_kem/internals/math/field.hpp"
 #include "ml_kem/internals/poly/serialize.hpp"
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 namespace {
 
 // Fuzzer for polynomial serialization (encode/decode) round-trip consistency.
-// Ensures that decode(encode(poly)) == poly for all bit-widths l in {1, 4, 5, 10, 11, 12}.
+// Ensures that decode(encode(poly)) == poly for all bit-widths l in {1, 4, 5, 10, 11, 12}, and that ( possibly vectorized ) encoding
+// and decoding of signed 16 -bit coefficients agrees with it.
 template<size_t l>
 void
 fuzz_serialize_round_trip(const uint8_t* data, size_t size)
@@ -42,6 +45,32 @@ fuzz_serialize_round_trip(const uint8_t* data, size_t size)
       __builtin_trap();
     }
   }
+
+  // Cross-check: Encoding signed 16 -bit coefficients ( vectorized, when CPU supports it ) must produce identical bytes
+  std::array<int16_t, ml_kem_ntt::N> poly_i16{};
+  std::array<uint8_t, 32 * l> serialized_i16{};
+
+  for (size_t i = 0; i < ml_kem_ntt::N; ++i) {
+    poly_i16[i] = static_cast<int16_t>(poly_orig[i].raw());
+  }
+
+  ml_kem_utils::encode<l>(std::span<const int16_t, ml_kem_ntt::N>(poly_i16), serialized_i16);
+  if (serialized_i16 != serialized) {
+    __builtin_trap();
+  }
+
+  // Cross-check: Decoding arbitrary bytes into signed 16 -bit coefficients must produce identical coefficients
+  std::array<uint8_t, 32 * l> raw_bytes{};
+  std::copy_n(data + size - raw_bytes.size(), raw_bytes.size(), raw_bytes.begin());
+
+  ml_kem_utils::decode<l>(std::span<const uint8_t, 32 * l>(raw_bytes), poly_work);
+  ml_kem_utils::decode<l>(std::span<const uint8_t, 32 * l>(raw_bytes), poly_i16);
+
+  for (size_t i = 0; i < ml_kem_ntt::N; ++i) {
+    if (static_cast<uint32_t>(poly_i16[i]) != poly_work[i].raw()) {
+      __builtin_trap();
+    }
+  }
 }
 
 }
@@ -310,6 +310,10 @@ TEST(ML_KEM, ML_KEM_1024_DecapsKeyCheck_ACVP_KnownAnswerTests)
         EXPECT_NE(computed_shared_secret_sender, computed_shared_secret_receiver);
       }
 
+      // Hash check is performed explicitly, when preparing secret key
+      ml_kem_1024::prepared_seckey prepared_sk{};
+      EXPECT_EQ(ml_kem_1024::prepare_seckey(sk, prepared_sk), test_passed);
+
       std::string empty_line;
       std::getline(file, empty_line);
     } else {
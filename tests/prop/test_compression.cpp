@@ -1,4 +1,5 @@
 #include "ml_kem/internals/poly/compression.hpp"
+#include "ml_kem/internals/poly/serialize.hpp"
 #include "ml_kem/internals/utility/force_inline.hpp"
 #include "randomshake/randomshake.hpp"
 #include <array>
@@ -69,6 +70,49 @@ test_zq_compression()
   return res;
 }
 
+// Test that fused `compress_encode<d>` produces same bytes as `poly_compress<d>` followed by `encode<d>`, for every x ∈ [0, q), as well
+// as for random lazily reduced coefficients, and that fused `decode_decompress<d>` produces same coefficients as `decode<d>` followed by
+// `poly_decompress<d>`, for random bytes.
+template<size_t d>
+void
+test_fused_compression(randomshake::randomshake_t<>& csprng)
+{
+  constexpr size_t blen = 32 * d;
+  constexpr size_t poly_cnt = (ml_kem_field::Q + ml_kem_ntt::N - 1) / ml_kem_ntt::N;
+
+  std::array<int16_t, ml_kem_ntt::N> poly{};
+  std::array<int16_t, ml_kem_ntt::N> expected_poly{};
+  std::array<uint8_t, blen> bytes{};
+  std::array<uint8_t, blen> expected_bytes{};
+
+  for (size_t i = 0; i < poly_cnt + 1; i++) {
+    if (i < poly_cnt) {
+      for (size_t j = 0; j < ml_kem_ntt::N; j++) {
+        poly[j] = static_cast<int16_t>(((i * ml_kem_ntt::N) + j) % ml_kem_field::Q);
+      }
+    } else {
+      csprng.generate(std::span(reinterpret_cast<uint8_t*>(poly.data()), sizeof(poly))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+    }
+
+    expected_poly = poly;
+    ml_kem_utils::poly_compress<d>(expected_poly);
+    ml_kem_utils::encode<d>(std::span<const int16_t, ml_kem_ntt::N>(expected_poly), expected_bytes);
+
+    ml_kem_utils::compress_encode<d>(poly, bytes);
+
+    EXPECT_EQ(bytes, expected_bytes);
+  }
+
+  csprng.generate(bytes);
+
+  ml_kem_utils::decode<d>(std::span<const uint8_t, blen>(bytes), expected_poly);
+  ml_kem_utils::poly_decompress<d>(expected_poly);
+
+  ml_kem_utils::decode_decompress<d>(bytes, poly);
+
+  EXPECT_EQ(poly, expected_poly);
+}
+
 }
 
 TEST(ML_KEM, CompressDecompressZq)
@@ -79,3 +123,18 @@ TEST(ML_KEM, CompressDecompressZq)
   EXPECT_TRUE((test_zq_compression<4, 1UL << 20>()));
   EXPECT_TRUE((test_zq_compression<1, 1UL << 20>()));
 }
+
+TEST(ML_KEM, FusedCompressEncodeMatchesSeparateSteps)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 6;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    test_fused_compression<11>(csprng);
+    test_fused_compression<10>(csprng);
+    test_fused_compression<5>(csprng);
+    test_fused_compression<4>(csprng);
+    test_fused_compression<1>(csprng);
+  }
+}
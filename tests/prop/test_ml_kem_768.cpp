@@ -1,7 +1,49 @@
 #include "ml_kem/ml_kem_768.hpp"
+#include "ml_kem/ml_kem_768_engine.hpp"
 #include "randomshake/randomshake.hpp"
 #include "test_helper.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <future>
 #include <gtest/gtest.h>
+#include <memory>
+#include <new>
+#include <vector>
+
+// While set, allocating a ML-KEM-768 batch workspace, which is what engine workers do on first use, throws std::bad_alloc. Over-aligned
+// allocation functions are replaced for this, as the batch workspace is cache-line aligned. Deallocation functions are kept out of line,
+// s.t. the compiler doesn't pair their `free` with `operator new`, after inlining.
+static std::atomic<bool> fail_batch_workspace_alloc{ false };
+
+void*
+operator new(std::size_t size, std::align_val_t align)
+{
+  if (fail_batch_workspace_alloc.load() && (size == sizeof(ml_kem_768::batch_workspace))) {
+    throw std::bad_alloc();
+  }
+
+  const auto alignment = static_cast<std::size_t>(align);
+  void* ptr = std::aligned_alloc(alignment, ((std::max<std::size_t>(size, 1) + alignment - 1) / alignment) * alignment);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+
+  return ptr;
+}
+
+[[gnu::noinline]] void
+operator delete(void* ptr, std::align_val_t) noexcept
+{
+  std::free(ptr);
+}
+
+[[gnu::noinline]] void
+operator delete(void* ptr, std::size_t, std::align_val_t) noexcept
+{
+  std::free(ptr);
+}
 
 // For ML-KEM-768
 //
@@ -138,3 +180,693 @@ TEST(ML_KEM, ML_KEM_768_EncapsFailureDueToRandomGarbagePubKey)
 
   EXPECT_FALSE(is_encapsulated);
 }
+
+// For ML-KEM-768
+//
+// - Generate a valid keypair and prepare its public key.
+// - Encapsulating to the prepared public key must produce same cipher text and shared secret as encapsulating to the byte serialized one.
+// - Receiver must be able to decapsulate it, producing same shared secret.
+// - Preparing a malformed public key must fail.
+TEST(ML_KEM, ML_KEM_768_PreparedPubKeyEncapsMatchesEncaps)
+{
+  constexpr size_t ITERATION_COUNT = 16;
+
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_768::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_768::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_768::SKEY_BYTE_LEN> seckey{};
+  std::array<uint8_t, ml_kem_768::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_768::CIPHER_TEXT_BYTE_LEN> cipher_prepared{};
+
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_sender_prepared{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+
+  ml_kem_768::prepared_pubkey prepared{};
+
+  randomshake::randomshake_t csprng{};
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+
+  ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+  EXPECT_TRUE(ml_kem_768::prepare_pubkey(pubkey, prepared));
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed_m);
+
+    const auto is_encapsulated = ml_kem_768::encapsulate(seed_m, pubkey, cipher, shared_secret_sender);
+    ml_kem_768::encapsulate(seed_m, prepared, cipher_prepared, shared_secret_sender_prepared);
+    ml_kem_768::decapsulate(seckey, cipher_prepared, shared_secret_receiver);
+
+    EXPECT_TRUE(is_encapsulated);
+    EXPECT_EQ(cipher, cipher_prepared);
+    EXPECT_EQ(shared_secret_sender, shared_secret_sender_prepared);
+    EXPECT_EQ(shared_secret_sender_prepared, shared_secret_receiver);
+  }
+
+  make_malformed_pubkey<pubkey.size()>(pubkey);
+  EXPECT_FALSE(ml_kem_768::prepare_pubkey(pubkey, prepared));
+}
+
+// For ML-KEM-768
+//
+// - Generate a valid keypair and prepare its secret key.
+// - Decapsulating using the prepared secret key must produce same shared secret as decapsulating using the byte serialized one, both
+//   for a valid cipher text and for a bit-flipped one, which must be *implicitly* rejected.
+// - Preparing a secret key, whose embedded public key doesn't hash to the digest held in it, must fail.
+TEST(ML_KEM, ML_KEM_768_PreparedSecKeyDecapsMatchesDecaps)
+{
+  constexpr size_t ITERATION_COUNT = 16;
+
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_768::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_768::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_768::SKEY_BYTE_LEN> seckey{};
+  std::array<uint8_t, ml_kem_768::CIPHER_TEXT_BYTE_LEN> cipher{};
+
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_receiver_prepared{};
+
+  ml_kem_768::prepared_seckey prepared{};
+
+  randomshake::randomshake_t csprng{};
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+
+  ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+  EXPECT_TRUE(ml_kem_768::prepare_seckey(seckey, prepared));
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed_m);
+
+    const auto is_encapsulated = ml_kem_768::encapsulate(seed_m, pubkey, cipher, shared_secret_sender);
+    ml_kem_768::decapsulate(prepared, cipher, shared_secret_receiver_prepared);
+
+    EXPECT_TRUE(is_encapsulated);
+    EXPECT_EQ(shared_secret_sender, shared_secret_receiver_prepared);
+
+    random_bitflip_in_cipher_text<cipher.size()>(cipher, csprng);
+    ml_kem_768::decapsulate(seckey, cipher, shared_secret_receiver);
+    ml_kem_768::decapsulate(prepared, cipher, shared_secret_receiver_prepared);
+
+    EXPECT_NE(shared_secret_sender, shared_secret_receiver_prepared);
+    EXPECT_EQ(shared_secret_receiver, shared_secret_receiver_prepared);
+  }
+
+  // Flip a bit of the digest of public key, held in secret key
+  seckey[seckey.size() - 64] ^= 0x01;
+  EXPECT_FALSE(ml_kem_768::prepare_seckey(seckey, prepared));
+}
+
+// Ensure that secret material of a prepared ML-KEM-768 secret key gets zeroized, when it goes out of scope.
+TEST(ML_KEM, ML_KEM_768_PreparedSecKeyZeroizedOnDestruction)
+{
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_768::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_768::SKEY_BYTE_LEN> seckey{};
+
+  randomshake::randomshake_t csprng{};
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+
+  ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+
+  // Prepared secret key lives in raw storage, s.t. its bytes can be inspected after its lifetime ends.
+  alignas(ml_kem_768::prepared_seckey) std::array<uint8_t, sizeof(ml_kem_768::prepared_seckey)> storage{};
+  auto* prepared = std::construct_at(reinterpret_cast<ml_kem_768::prepared_seckey*>(storage.data()));
+
+  EXPECT_TRUE(ml_kem_768::prepare_seckey(seckey, *prepared));
+
+  using prepared_t = ml_kem_768::prepared_seckey;
+
+  const auto is_zero = [&](const size_t off, const size_t len) {
+    const auto bytes = std::span(storage).subspan(off, len);
+    return std::all_of(bytes.begin(), bytes.end(), [](const uint8_t v) { return v == 0; });
+  };
+
+  EXPECT_FALSE(is_zero(offsetof(prepared_t, s_prime), sizeof(prepared_t::s_prime)));
+  EXPECT_FALSE(is_zero(offsetof(prepared_t, z), sizeof(prepared_t::z)));
+
+  std::destroy_at(prepared);
+
+  EXPECT_TRUE(is_zero(offsetof(prepared_t, s_prime), sizeof(prepared_t::s_prime)));
+  EXPECT_TRUE(is_zero(offsetof(prepared_t, s_cache), sizeof(prepared_t::s_cache)));
+  EXPECT_TRUE(is_zero(offsetof(prepared_t, z), sizeof(prepared_t::z)));
+}
+
+// For ML-KEM-768
+//
+// Key generation, encapsulation and decapsulation, expanding public matrix A one row at a time, instead of materializing it, must
+// produce same keys, cipher text and shared secrets.
+TEST(ML_KEM, ML_KEM_768_StreamedMatrixMatchesMaterialized)
+{
+  using namespace ml_kem_768;
+
+  std::array<uint8_t, SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, SKEY_BYTE_LEN> seckey{};
+  std::array<uint8_t, CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+
+  std::array<uint8_t, PKEY_BYTE_LEN> pubkey_streamed{};
+  std::array<uint8_t, SKEY_BYTE_LEN> seckey_streamed{};
+  std::array<uint8_t, CIPHER_TEXT_BYTE_LEN> cipher_streamed{};
+  std::array<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret_sender_streamed{};
+  std::array<uint8_t, SHARED_SECRET_BYTE_LEN> shared_secret_receiver_streamed{};
+
+  randomshake::randomshake_t csprng{};
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  ml_kem::keygen<k, eta1, false>(seed_d, seed_z, pubkey, seckey);
+  ml_kem::keygen<k, eta1, true>(seed_d, seed_z, pubkey_streamed, seckey_streamed);
+
+  EXPECT_EQ(pubkey, pubkey_streamed);
+  EXPECT_EQ(seckey, seckey_streamed);
+
+  EXPECT_TRUE((ml_kem::encapsulate<k, eta1, eta2, du, dv, false>(seed_m, pubkey, cipher, shared_secret_sender)));
+  EXPECT_TRUE((ml_kem::encapsulate<k, eta1, eta2, du, dv, true>(seed_m, pubkey, cipher_streamed, shared_secret_sender_streamed)));
+
+  EXPECT_EQ(cipher, cipher_streamed);
+  EXPECT_EQ(shared_secret_sender, shared_secret_sender_streamed);
+
+  random_bitflip_in_cipher_text<cipher.size()>(cipher, csprng);
+
+  ml_kem::decapsulate<k, eta1, eta2, du, dv, false>(seckey, cipher, shared_secret_receiver);
+  ml_kem::decapsulate<k, eta1, eta2, du, dv, true>(seckey, cipher, shared_secret_receiver_streamed);
+
+  EXPECT_EQ(shared_secret_receiver, shared_secret_receiver_streamed);
+
+  make_malformed_pubkey<pubkey.size()>(pubkey);
+  EXPECT_FALSE((ml_kem::encapsulate<k, eta1, eta2, du, dv, true>(seed_m, pubkey, cipher_streamed, shared_secret_sender_streamed)));
+}
+
+// For ML-KEM-768
+//
+// Key generation, encapsulation and decapsulation, using a single caller-supplied workspace, reused across calls without clearing it,
+// must produce same keys, cipher texts and shared secrets, as produced when using a fresh workspace on stack, in each call.
+TEST(ML_KEM, ML_KEM_768_WorkspaceReuseMatchesStackWorkspace)
+{
+  constexpr size_t ITERATION_COUNT = 8;
+
+  static_assert(ml_kem_768::WORKSPACE_BYTES == sizeof(ml_kem_768::workspace));
+  static_assert(alignof(ml_kem_768::workspace) == 64, "Workspace must be cache-line aligned");
+
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  std::array<uint8_t, ml_kem_768::SEED_M_BYTE_LEN> seed_m{};
+
+  std::array<uint8_t, ml_kem_768::PKEY_BYTE_LEN> pubkey{};
+  std::array<uint8_t, ml_kem_768::SKEY_BYTE_LEN> seckey{};
+  std::array<uint8_t, ml_kem_768::CIPHER_TEXT_BYTE_LEN> cipher{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_sender{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_receiver{};
+
+  std::array<uint8_t, ml_kem_768::PKEY_BYTE_LEN> pubkey_ws{};
+  std::array<uint8_t, ml_kem_768::SKEY_BYTE_LEN> seckey_ws{};
+  std::array<uint8_t, ml_kem_768::CIPHER_TEXT_BYTE_LEN> cipher_ws{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_sender_ws{};
+  std::array<uint8_t, ml_kem_768::SHARED_SECRET_BYTE_LEN> shared_secret_receiver_ws{};
+
+  auto ws = std::make_unique<ml_kem_768::workspace>();
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(ws.get()) % 64, 0U); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed_d);
+    csprng.generate(seed_z);
+    csprng.generate(seed_m);
+
+    ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+    ml_kem_768::keygen(seed_d, seed_z, pubkey_ws, seckey_ws, *ws);
+
+    EXPECT_EQ(pubkey, pubkey_ws);
+    EXPECT_EQ(seckey, seckey_ws);
+
+    EXPECT_TRUE(ml_kem_768::encapsulate(seed_m, pubkey, cipher, shared_secret_sender));
+    EXPECT_TRUE(ml_kem_768::encapsulate(seed_m, pubkey, cipher_ws, shared_secret_sender_ws, *ws));
+
+    EXPECT_EQ(cipher, cipher_ws);
+    EXPECT_EQ(shared_secret_sender, shared_secret_sender_ws);
+
+    // Alternate between valid and bit flipped cipher texts, exercising both branches of implicit rejection.
+    if ((i & 1U) == 1U) {
+      random_bitflip_in_cipher_text<cipher.size()>(cipher, csprng);
+    }
+
+    ml_kem_768::decapsulate(seckey, cipher, shared_secret_receiver);
+    ml_kem_768::decapsulate(seckey, cipher, shared_secret_receiver_ws, *ws);
+
+    EXPECT_EQ(shared_secret_receiver, shared_secret_receiver_ws);
+    EXPECT_EQ(shared_secret_receiver == shared_secret_sender, (i & 1U) == 0U);
+  }
+
+  make_malformed_pubkey<pubkey.size()>(pubkey);
+  EXPECT_FALSE(ml_kem_768::encapsulate(seed_m, pubkey, cipher_ws, shared_secret_sender_ws, *ws));
+}
+
+// Ensure that batched key generation produces same keypairs as sequential key generation does, for batch sizes which leave no, one and
+// more than one keypair beyond full multi-lane chunks, and that it refuses spans of mismatching length.
+TEST(ML_KEM, ML_KEM_768_KeygenBatchMatchesSequential)
+{
+  auto ws = std::make_unique<ml_kem_768::batch_workspace>();
+  randomshake::randomshake_t csprng{};
+
+  for (const size_t batch_size : { 0UL, 1UL, 2UL, 3UL, 4UL, 5UL, 7UL, 8UL, 9UL, 13UL, 17UL }) {
+    std::vector<ml_kem_768::seed_pair_t> seeds(batch_size);
+    std::vector<ml_kem_768::pubkey_t> pubkeys(batch_size);
+    std::vector<ml_kem_768::seckey_t> seckeys(batch_size);
+
+    for (auto& seed : seeds) {
+      csprng.generate(seed.d);
+      csprng.generate(seed.z);
+    }
+
+    EXPECT_TRUE(ml_kem_768::keygen_batch(seeds, pubkeys, seckeys, *ws));
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::pubkey_t pubkey{};
+      ml_kem_768::seckey_t seckey{};
+
+      ml_kem_768::keygen(seeds[i].d, seeds[i].z, pubkey, seckey);
+
+      EXPECT_EQ(pubkeys[i], pubkey);
+      EXPECT_EQ(seckeys[i], seckey);
+    }
+
+    // Batch workspace allocated on heap, by the routine itself
+    std::vector<ml_kem_768::pubkey_t> pubkeys_heap(batch_size);
+    std::vector<ml_kem_768::seckey_t> seckeys_heap(batch_size);
+
+    EXPECT_TRUE(ml_kem_768::keygen_batch(seeds, pubkeys_heap, seckeys_heap));
+    EXPECT_EQ(pubkeys, pubkeys_heap);
+    EXPECT_EQ(seckeys, seckeys_heap);
+  }
+
+  std::vector<ml_kem_768::seed_pair_t> seeds(3);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(3);
+  std::vector<ml_kem_768::seckey_t> seckeys(2);
+
+  EXPECT_FALSE(ml_kem_768::keygen_batch(seeds, pubkeys, seckeys, *ws));
+  EXPECT_TRUE(std::all_of(pubkeys.begin(), pubkeys.end(), [](const auto& pubkey) { return pubkey == ml_kem_768::pubkey_t{}; }));
+}
+
+// Ensure that batched encapsulation produces same cipher texts and shared secrets as sequential encapsulation does, that it reports
+// malformed public keys in the returned bitmap, leaving their outputs untouched, and that it refuses spans of mismatching length.
+TEST(ML_KEM, ML_KEM_768_EncapsBatchMatchesSequential)
+{
+  auto ws = std::make_unique<ml_kem_768::batch_workspace>();
+  randomshake::randomshake_t csprng{};
+
+  for (const size_t batch_size : { 0UL, 1UL, 2UL, 3UL, 4UL, 5UL, 7UL, 8UL, 9UL, 13UL, 17UL }) {
+    std::vector<ml_kem_768::seed_pair_t> seeds(batch_size);
+    std::vector<ml_kem_768::pubkey_t> pubkeys(batch_size);
+    std::vector<ml_kem_768::seckey_t> seckeys(batch_size);
+    std::vector<ml_kem_768::seed_m_t> ms(batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      csprng.generate(seeds[i].d);
+      csprng.generate(seeds[i].z);
+      csprng.generate(ms[i]);
+    }
+
+    EXPECT_TRUE(ml_kem_768::keygen_batch(seeds, pubkeys, seckeys, *ws));
+
+    // Every third public key is malformed
+    for (size_t i = 1; i < batch_size; i += 3) {
+      make_malformed_pubkey<ml_kem_768::PKEY_BYTE_LEN>(pubkeys[i]);
+    }
+
+    constexpr uint8_t untouched = 0xa5;
+
+    ml_kem_768::cipher_text_t untouched_cipher{};
+    ml_kem_768::shared_secret_t untouched_shared_secret{};
+    untouched_cipher.fill(untouched);
+    untouched_shared_secret.fill(untouched);
+
+    std::vector<ml_kem_768::cipher_text_t> ciphers(batch_size, untouched_cipher);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets(batch_size, untouched_shared_secret);
+
+    const auto is_valid = ml_kem_768::encapsulate_batch(ms, pubkeys, ciphers, shared_secrets, *ws);
+    EXPECT_EQ(is_valid.size(), batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::cipher_text_t cipher = untouched_cipher;
+      ml_kem_768::shared_secret_t shared_secret = untouched_shared_secret;
+
+      const bool is_encapsulated = ml_kem_768::encapsulate(ms[i], pubkeys[i], cipher, shared_secret);
+
+      EXPECT_EQ(is_valid[i], is_encapsulated);
+      EXPECT_EQ(is_valid[i], (i % 3) != 1);
+      EXPECT_EQ(ciphers[i], cipher);
+      EXPECT_EQ(shared_secrets[i], shared_secret);
+
+      if (is_encapsulated) {
+        ml_kem_768::shared_secret_t shared_secret_receiver{};
+        ml_kem_768::decapsulate(seckeys[i], ciphers[i], shared_secret_receiver);
+
+        EXPECT_EQ(shared_secrets[i], shared_secret_receiver);
+      } else {
+        EXPECT_EQ(ciphers[i], untouched_cipher);
+        EXPECT_EQ(shared_secrets[i], untouched_shared_secret);
+      }
+    }
+
+    // Batch workspace allocated on heap, by the routine itself
+    std::vector<ml_kem_768::cipher_text_t> ciphers_heap(batch_size, untouched_cipher);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_heap(batch_size, untouched_shared_secret);
+
+    EXPECT_EQ(ml_kem_768::encapsulate_batch(ms, pubkeys, ciphers_heap, shared_secrets_heap), is_valid);
+    EXPECT_EQ(ciphers, ciphers_heap);
+    EXPECT_EQ(shared_secrets, shared_secrets_heap);
+  }
+
+  std::vector<ml_kem_768::seed_m_t> ms(3);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(3);
+  std::vector<ml_kem_768::cipher_text_t> ciphers(3);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(2);
+
+  EXPECT_TRUE(ml_kem_768::encapsulate_batch(ms, pubkeys, ciphers, shared_secrets, *ws).empty());
+}
+
+// Ensure that batched decapsulation, using either byte serialized or prepared secret key, produces same shared secrets as sequential
+// decapsulation does, both for well-formed and bit-flipped cipher texts, and that it refuses spans of mismatching length.
+TEST(ML_KEM, ML_KEM_768_DecapsBatchMatchesSequential)
+{
+  auto ws = std::make_unique<ml_kem_768::batch_workspace>();
+  randomshake::randomshake_t csprng{};
+
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  ml_kem_768::pubkey_t pubkey{};
+  ml_kem_768::seckey_t seckey{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+
+  auto prepared = std::make_unique<ml_kem_768::prepared_seckey>();
+  EXPECT_TRUE(ml_kem_768::prepare_seckey(seckey, *prepared));
+
+  for (const size_t batch_size : { 0UL, 1UL, 2UL, 3UL, 4UL, 5UL, 7UL, 8UL, 9UL, 13UL, 17UL }) {
+    std::vector<ml_kem_768::seed_m_t> ms(batch_size);
+    std::vector<ml_kem_768::cipher_text_t> ciphers(batch_size);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_sender(batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      csprng.generate(ms[i]);
+      EXPECT_TRUE(ml_kem_768::encapsulate(ms[i], pubkey, ciphers[i], shared_secrets_sender[i]));
+    }
+
+    // Every third cipher text is bit-flipped, s.t. it gets implicitly rejected
+    for (size_t i = 1; i < batch_size; i += 3) {
+      random_bitflip_in_cipher_text<ml_kem_768::CIPHER_TEXT_BYTE_LEN>(ciphers[i], csprng);
+    }
+
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets(batch_size);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_prepared(batch_size);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_heap(batch_size);
+
+    EXPECT_TRUE(ml_kem_768::decapsulate_batch(seckey, ciphers, shared_secrets, *ws));
+    EXPECT_TRUE(ml_kem_768::decapsulate_batch(*prepared, ciphers, shared_secrets_prepared, *ws));
+    EXPECT_TRUE(ml_kem_768::decapsulate_batch(seckey, ciphers, shared_secrets_heap));
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::shared_secret_t shared_secret{};
+      ml_kem_768::decapsulate(seckey, ciphers[i], shared_secret);
+
+      EXPECT_EQ(shared_secrets[i], shared_secret);
+      EXPECT_EQ(shared_secrets_prepared[i], shared_secret);
+      EXPECT_EQ(shared_secrets_heap[i], shared_secret);
+      EXPECT_EQ(shared_secrets[i] == shared_secrets_sender[i], (i % 3) != 1);
+    }
+  }
+
+  std::vector<ml_kem_768::cipher_text_t> ciphers(3);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(2);
+
+  EXPECT_FALSE(ml_kem_768::decapsulate_batch(seckey, ciphers, shared_secrets, *ws));
+  EXPECT_FALSE(ml_kem_768::decapsulate_batch(*prepared, ciphers, shared_secrets));
+}
+
+// Ensure that batched decapsulation, using a byte serialized secret key, whose embedded public key fails the modulus check, still produces
+// same shared secrets as sequential decapsulation does, while such a secret key can't be prepared.
+TEST(ML_KEM, ML_KEM_768_DecapsBatchWithNonReducedEmbeddedPubKey)
+{
+  auto ws = std::make_unique<ml_kem_768::batch_workspace>();
+  randomshake::randomshake_t csprng{};
+
+  std::array<uint8_t, ml_kem_768::SEED_D_BYTE_LEN> seed_d{};
+  std::array<uint8_t, ml_kem_768::SEED_Z_BYTE_LEN> seed_z{};
+  ml_kem_768::pubkey_t pubkey{};
+  ml_kem_768::seckey_t seckey{};
+
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  ml_kem_768::keygen(seed_d, seed_z, pubkey, seckey);
+
+  constexpr size_t pke_sk_len = ml_kem_768::SKEY_BYTE_LEN - ml_kem_768::PKEY_BYTE_LEN - 64;
+  make_malformed_pubkey<ml_kem_768::PKEY_BYTE_LEN>(std::span(seckey).subspan<pke_sk_len, ml_kem_768::PKEY_BYTE_LEN>());
+
+  auto prepared = std::make_unique<ml_kem_768::prepared_seckey>();
+  EXPECT_FALSE(ml_kem_768::prepare_seckey(seckey, *prepared));
+
+  constexpr size_t batch_size = 9;
+
+  std::vector<ml_kem_768::seed_m_t> ms(batch_size);
+  std::vector<ml_kem_768::cipher_text_t> ciphers(batch_size);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets_sender(batch_size);
+
+  for (size_t i = 0; i < batch_size; i++) {
+    csprng.generate(ms[i]);
+    EXPECT_TRUE(ml_kem_768::encapsulate(ms[i], pubkey, ciphers[i], shared_secrets_sender[i]));
+  }
+
+  // An all-zero cipher text is the only one, which matches re-encryption of `decapsulate`, under such a secret key
+  std::fill(ciphers[2].begin(), ciphers[2].end(), 0);
+
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(batch_size);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets_heap(batch_size);
+
+  EXPECT_TRUE(ml_kem_768::decapsulate_batch(seckey, ciphers, shared_secrets, *ws));
+  EXPECT_TRUE(ml_kem_768::decapsulate_batch(seckey, ciphers, shared_secrets_heap));
+
+  for (size_t i = 0; i < batch_size; i++) {
+    ml_kem_768::shared_secret_t shared_secret{};
+    ml_kem_768::decapsulate(seckey, ciphers[i], shared_secret);
+
+    EXPECT_EQ(shared_secrets[i], shared_secret);
+    EXPECT_EQ(shared_secrets_heap[i], shared_secret);
+  }
+}
+
+// Ensure that trial decapsulation of a cipher text under many prepared secret keys produces same shared secrets as sequential
+// decapsulation does under each of those keys, s.t. only the key, which the cipher text was encapsulated to, yields sender's shared secret.
+TEST(ML_KEM, ML_KEM_768_DecapsManyKeysMatchesSequential)
+{
+  auto ws = std::make_unique<ml_kem_768::batch_workspace>();
+  randomshake::randomshake_t csprng{};
+
+  for (const size_t batch_size : { 1UL, 2UL, 3UL, 4UL, 5UL, 7UL, 8UL, 9UL, 13UL, 17UL }) {
+    std::vector<ml_kem_768::seed_pair_t> seeds(batch_size);
+    std::vector<ml_kem_768::pubkey_t> pubkeys(batch_size);
+    std::vector<ml_kem_768::seckey_t> seckeys(batch_size);
+    std::vector<ml_kem_768::prepared_seckey> prepared(batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      csprng.generate(seeds[i].d);
+      csprng.generate(seeds[i].z);
+    }
+
+    EXPECT_TRUE(ml_kem_768::keygen_batch(seeds, pubkeys, seckeys, *ws));
+
+    for (size_t i = 0; i < batch_size; i++) {
+      EXPECT_TRUE(ml_kem_768::prepare_seckey(seckeys[i], prepared[i]));
+    }
+
+    // Cipher text is encapsulated to the last but one key
+    const size_t recipient = (batch_size > 1) ? (batch_size - 2) : 0;
+
+    ml_kem_768::seed_m_t seed_m{};
+    ml_kem_768::cipher_text_t cipher{};
+    ml_kem_768::shared_secret_t shared_secret_sender{};
+
+    csprng.generate(seed_m);
+    EXPECT_TRUE(ml_kem_768::encapsulate(seed_m, pubkeys[recipient], cipher, shared_secret_sender));
+
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets(batch_size);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_heap(batch_size);
+
+    EXPECT_TRUE(ml_kem_768::decapsulate_many_keys(prepared, cipher, shared_secrets, *ws));
+    EXPECT_TRUE(ml_kem_768::decapsulate_many_keys(prepared, cipher, shared_secrets_heap));
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::shared_secret_t shared_secret{};
+      ml_kem_768::decapsulate(seckeys[i], cipher, shared_secret);
+
+      EXPECT_EQ(shared_secrets[i], shared_secret);
+      EXPECT_EQ(shared_secrets_heap[i], shared_secret);
+      EXPECT_EQ(shared_secrets[i] == shared_secret_sender, i == recipient);
+    }
+  }
+
+  std::vector<ml_kem_768::prepared_seckey> prepared(3);
+  ml_kem_768::cipher_text_t cipher{};
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(2);
+
+  EXPECT_FALSE(ml_kem_768::decapsulate_many_keys(prepared, cipher, shared_secrets, *ws));
+}
+
+// Ensure that key generation, encapsulation and decapsulation jobs, run by a pool of worker threads, produce same outputs as sequential
+// routines do, for batches which are split into many chunks, and that jobs over spans of mismatching length fail right away.
+TEST(ML_KEM, ML_KEM_768_EngineMatchesSequential)
+{
+  ml_kem_768::engine eng{ 3 };
+  randomshake::randomshake_t csprng{};
+
+  EXPECT_EQ(eng.worker_count(), 3UL);
+
+  for (const size_t batch_size : { 0UL, 1UL, 7UL, 8UL, 9UL, 61UL }) {
+    std::vector<ml_kem_768::seed_pair_t> seeds(batch_size);
+    std::vector<ml_kem_768::pubkey_t> pubkeys(batch_size);
+    std::vector<ml_kem_768::seckey_t> seckeys(batch_size);
+    std::vector<ml_kem_768::seed_m_t> ms(batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      csprng.generate(seeds[i].d);
+      csprng.generate(seeds[i].z);
+      csprng.generate(ms[i]);
+    }
+
+    EXPECT_TRUE(ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys).get());
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::pubkey_t pubkey{};
+      ml_kem_768::seckey_t seckey{};
+      ml_kem_768::keygen(seeds[i].d, seeds[i].z, pubkey, seckey);
+
+      EXPECT_EQ(pubkeys[i], pubkey);
+      EXPECT_EQ(seckeys[i], seckey);
+    }
+
+    // Every fifth public key is malformed
+    for (size_t i = 3; i < batch_size; i += 5) {
+      make_malformed_pubkey<ml_kem_768::PKEY_BYTE_LEN>(pubkeys[i]);
+    }
+
+    std::vector<ml_kem_768::cipher_text_t> ciphers(batch_size);
+    std::vector<ml_kem_768::shared_secret_t> shared_secrets_sender(batch_size);
+
+    const auto is_valid = ml_kem_768::encapsulate_batch(eng, ms, pubkeys, ciphers, shared_secrets_sender).get();
+    EXPECT_EQ(is_valid.size(), batch_size);
+
+    for (size_t i = 0; i < batch_size; i++) {
+      ml_kem_768::cipher_text_t cipher{};
+      ml_kem_768::shared_secret_t shared_secret{};
+
+      EXPECT_EQ(is_valid[i], ml_kem_768::encapsulate(ms[i], pubkeys[i], cipher, shared_secret));
+      EXPECT_EQ(is_valid[i], (i % 5) != 3);
+
+      if (is_valid[i]) {
+        EXPECT_EQ(ciphers[i], cipher);
+        EXPECT_EQ(shared_secrets_sender[i], shared_secret);
+      }
+    }
+
+    // All cipher texts are decapsulated using the first secret key, s.t. the ones encapsulated to other keys get implicitly rejected.
+    if (batch_size > 0) {
+      auto prepared = std::make_unique<ml_kem_768::prepared_seckey>();
+      EXPECT_TRUE(ml_kem_768::prepare_seckey(seckeys[0], *prepared));
+
+      std::vector<ml_kem_768::shared_secret_t> shared_secrets_receiver(batch_size);
+
+      std::promise<bool> done{};
+      auto is_done = done.get_future();
+
+      ml_kem_768::decapsulate_batch(eng, *prepared, ciphers, shared_secrets_receiver, [&](const bool result) { done.set_value(result); });
+      EXPECT_TRUE(is_done.get());
+
+      for (size_t i = 0; i < batch_size; i++) {
+        ml_kem_768::shared_secret_t shared_secret{};
+        ml_kem_768::decapsulate(seckeys[0], ciphers[i], shared_secret);
+
+        EXPECT_EQ(shared_secrets_receiver[i], shared_secret);
+      }
+    }
+  }
+
+  std::vector<ml_kem_768::seed_pair_t> seeds(3);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(3);
+  std::vector<ml_kem_768::seckey_t> seckeys(2);
+
+  EXPECT_FALSE(ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys).get());
+}
+
+// Ensure that an exception, thrown while computing a chunk of an engine job, doesn't escape the worker, but fails the job, s.t. the future
+// holds the exception, while a callback is invoked with false ( or an empty bitmap ). The engine keeps serving jobs afterwards.
+TEST(ML_KEM, ML_KEM_768_EngineRoutesFailureToJob)
+{
+  ml_kem_768::engine eng{ 2 };
+  randomshake::randomshake_t csprng{};
+
+  constexpr size_t batch_size = 17;
+
+  std::vector<ml_kem_768::seed_pair_t> seeds(batch_size);
+  std::vector<ml_kem_768::pubkey_t> pubkeys(batch_size);
+  std::vector<ml_kem_768::seckey_t> seckeys(batch_size);
+  std::vector<ml_kem_768::seed_m_t> ms(batch_size);
+  std::vector<ml_kem_768::cipher_text_t> ciphers(batch_size);
+  std::vector<ml_kem_768::shared_secret_t> shared_secrets(batch_size);
+
+  for (size_t i = 0; i < batch_size; i++) {
+    csprng.generate(seeds[i].d);
+    csprng.generate(seeds[i].z);
+    csprng.generate(ms[i]);
+  }
+
+  // Workers of a fresh engine have no batch workspace yet, so each chunk fails allocating one
+  fail_batch_workspace_alloc = true;
+
+  auto keygen_done = ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys);
+  EXPECT_THROW((void)keygen_done.get(), std::bad_alloc);
+
+  auto encaps_done = ml_kem_768::encapsulate_batch(eng, ms, pubkeys, ciphers, shared_secrets);
+  EXPECT_THROW((void)encaps_done.get(), std::bad_alloc);
+
+  std::promise<bool> keygen_result{};
+  auto is_generated = keygen_result.get_future();
+
+  ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys, [&](const bool result) { keygen_result.set_value(result); });
+  EXPECT_FALSE(is_generated.get());
+
+  std::promise<std::vector<bool>> encaps_result{};
+  auto is_valid = encaps_result.get_future();
+
+  ml_kem_768::encapsulate_batch(eng, ms, pubkeys, ciphers, shared_secrets, [&](std::vector<bool> result) { encaps_result.set_value(std::move(result)); });
+  EXPECT_TRUE(is_valid.get().empty());
+
+  fail_batch_workspace_alloc = false;
+
+  EXPECT_TRUE(ml_kem_768::keygen_batch(eng, seeds, pubkeys, seckeys).get());
+
+  for (size_t i = 0; i < batch_size; i++) {
+    ml_kem_768::pubkey_t pubkey{};
+    ml_kem_768::seckey_t seckey{};
+    ml_kem_768::keygen(seeds[i].d, seeds[i].z, pubkey, seckey);
+
+    EXPECT_EQ(pubkeys[i], pubkey);
+    EXPECT_EQ(seckeys[i], seckey);
+  }
+}
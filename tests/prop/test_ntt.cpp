@@ -0,0 +1,307 @@
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/poly/ntt.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <gtest/gtest.h>
+
+namespace {
+
+using poly_t = std::array<ml_kem_field::zq_t, ml_kem_ntt::N>;
+
+poly_t
+random_poly(randomshake::randomshake_t<>& csprng)
+{
+  poly_t poly{};
+  for (auto& coeff : poly) {
+    coeff = ml_kem_field::zq_t::random(csprng);
+  }
+
+  return poly;
+}
+
+using poly16_t = std::array<int16_t, ml_kem_ntt::N>;
+
+// Returns a signed 16 -bit representative ∈ (-q, q) of each coefficient, picking the negative one for every other coefficient.
+poly16_t
+to_signed_poly(const poly_t& poly)
+{
+  poly16_t res{};
+  for (size_t i = 0; i < poly.size(); i++) {
+    const auto v = static_cast<int16_t>(poly[i].raw());
+    res[i] = ((i & 1) == 0) ? v : static_cast<int16_t>(v - ml_kem_field::Q16);
+  }
+
+  return res;
+}
+
+// Returns canonical `zq_t` form of each coefficient, which must be ∈ [0, q).
+poly_t
+to_zq_poly(const poly16_t& poly)
+{
+  poly_t res{};
+  for (size_t i = 0; i < poly.size(); i++) {
+    EXPECT_GE(poly[i], 0);
+    EXPECT_LT(poly[i], ml_kem_field::Q16);
+
+    res[i] = ml_kem_field::zq_t(static_cast<uint32_t>(poly[i]));
+  }
+
+  return res;
+}
+
+// Checks NTT, iNTT and polynomial multiplication over signed 16 -bit coefficients, computed by given kernels, against the
+// `zq_t` reference implementation.
+template<typename ntt_fn_t, typename intt_fn_t, typename polymul_fn_t>
+void
+test_int16_kernels(ntt_fn_t ntt_fn, intt_fn_t intt_fn, polymul_fn_t polymul_fn)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 12;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    const auto f = random_poly(csprng);
+    const auto g = random_poly(csprng);
+
+    auto f_ntt_ref = f;
+    auto f_ntt = to_signed_poly(f);
+    ml_kem_ntt::scalar::ntt(f_ntt_ref);
+    ntt_fn(f_ntt);
+    EXPECT_EQ(to_zq_poly(f_ntt), f_ntt_ref);
+
+    auto f_intt_ref = f;
+    auto f_intt = to_signed_poly(f);
+    ml_kem_ntt::scalar::intt(f_intt_ref);
+    intt_fn(f_intt);
+    EXPECT_EQ(to_zq_poly(f_intt), f_intt_ref);
+
+    poly_t h_ref{};
+    poly16_t h{};
+    ml_kem_ntt::scalar::polymul(f, g, h_ref);
+    polymul_fn(to_signed_poly(f), to_signed_poly(g), h);
+    EXPECT_EQ(to_zq_poly(h), h_ref);
+  }
+}
+
+// Checks sum of products of `cnt` pairs of polynomials with signed 16 -bit coefficients, computed by given multiply-accumulate
+// kernel ( which is also handed multiplication cache of g_i ), against the sum of products computed by the `zq_t` reference implementation.
+template<size_t cnt, typename polymul_acc_fn_t>
+void
+test_polymul_acc_kernel(polymul_acc_fn_t polymul_acc_fn)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 10;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    std::array<int16_t, cnt * ml_kem_ntt::N> f{};
+    std::array<int16_t, cnt * ml_kem_ntt::N> g{};
+    poly_t h_ref{};
+
+    for (size_t j = 0; j < cnt; j++) {
+      const auto f_j = random_poly(csprng);
+      const auto g_j = random_poly(csprng);
+
+      poly_t prod{};
+      ml_kem_ntt::scalar::polymul(f_j, g_j, prod);
+      for (size_t idx = 0; idx < ml_kem_ntt::N; idx++) {
+        h_ref[idx] += prod[idx];
+      }
+
+      const auto f_j16 = to_signed_poly(f_j);
+      const auto g_j16 = to_signed_poly(g_j);
+      std::copy(f_j16.begin(), f_j16.end(), f.begin() + static_cast<ptrdiff_t>(j * ml_kem_ntt::N));
+      std::copy(g_j16.begin(), g_j16.end(), g.begin() + static_cast<ptrdiff_t>(j * ml_kem_ntt::N));
+    }
+
+    std::array<int16_t, cnt * ml_kem_ntt::N / 2> g_cache{};
+    for (size_t j = 0; j < cnt; j++) {
+      ml_kem_ntt::mulcache(std::span<const int16_t, ml_kem_ntt::N>(std::span(g).subspan(j * ml_kem_ntt::N, ml_kem_ntt::N)),
+                           std::span<int16_t, ml_kem_ntt::N / 2>(std::span(g_cache).subspan(j * ml_kem_ntt::N / 2, ml_kem_ntt::N / 2)));
+    }
+
+    poly16_t h{};
+    polymul_acc_fn(std::span<const int16_t, cnt * ml_kem_ntt::N>(f),
+                   std::span<const int16_t, cnt * ml_kem_ntt::N>(g),
+                   std::span<const int16_t, cnt * ml_kem_ntt::N / 2>(g_cache),
+                   std::span(h));
+    EXPECT_EQ(to_zq_poly(h), h_ref);
+  }
+}
+
+template<size_t cnt>
+void
+test_polymul_acc()
+{
+  using span_t = std::span<const int16_t, cnt * ml_kem_ntt::N>;
+  using cache_t = std::span<const int16_t, cnt * ml_kem_ntt::N / 2>;
+  using out_t = std::span<int16_t, ml_kem_ntt::N>;
+
+  test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t, out_t h) { ml_kem_ntt::scalar::polymul_acc<cnt, false>(f, g, h); });
+  test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t, out_t h) { ml_kem_ntt::scalar::polymul_acc<cnt, true>(f, g, h); });
+  test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t c, out_t h) { ml_kem_ntt::scalar::polymul_acc<cnt>(f, g, c, h); });
+  test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t, out_t h) { ml_kem_ntt::polymul_acc<cnt>(f, g, h); });
+  test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t c, out_t h) { ml_kem_ntt::polymul_acc<cnt>(f, g, c, h); });
+
+#if ML_KEM_X86_SIMD
+  if (ml_kem_cpu::has_avx2()) {
+    test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t, out_t h) { ml_kem_ntt::avx2::polymul_acc<cnt>(f, g, h); });
+    test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t c, out_t h) { ml_kem_ntt::avx2::polymul_acc<cnt>(f, g, c, h); });
+  }
+  if (ml_kem_cpu::has_avx512()) {
+    test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t, out_t h) { ml_kem_ntt::avx512::polymul_acc<cnt>(f, g, h); });
+    test_polymul_acc_kernel<cnt>([](span_t f, span_t g, cache_t c, out_t h) { ml_kem_ntt::avx512::polymul_acc<cnt>(f, g, c, h); });
+  }
+#endif
+}
+
+} // namespace
+
+// Ensure that NTT, iNTT and polynomial multiplication, as dispatched at runtime to the best implementation supported by the
+// executing CPU, produce bit-identical results to the portable reference implementation.
+TEST(ML_KEM, NTTDispatchMatchesScalarReference)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 12;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    const auto f = random_poly(csprng);
+    const auto g = random_poly(csprng);
+
+    auto f_ntt_ref = f;
+    auto f_ntt = f;
+    ml_kem_ntt::scalar::ntt(f_ntt_ref);
+    ml_kem_ntt::ntt(f_ntt);
+    EXPECT_EQ(f_ntt, f_ntt_ref);
+
+    auto f_intt_ref = f;
+    auto f_intt = f;
+    ml_kem_ntt::scalar::intt(f_intt_ref);
+    ml_kem_ntt::intt(f_intt);
+    EXPECT_EQ(f_intt, f_intt_ref);
+
+    poly_t h_ref{};
+    poly_t h{};
+    ml_kem_ntt::scalar::polymul(f, g, h_ref);
+    ml_kem_ntt::polymul(f, g, h);
+    EXPECT_EQ(h, h_ref);
+
+    ml_kem_ntt::intt(f_ntt);
+    EXPECT_EQ(f_ntt, f);
+  }
+}
+
+// Ensure that NTT, iNTT and polynomial multiplication over signed 16 -bit coefficients, using Montgomery arithmetic, produce same
+// canonical results as the `zq_t` reference implementation, both for the portable implementation and the dispatched one.
+TEST(ML_KEM, NTTInt16MatchesScalarReference)
+{
+  test_int16_kernels([](poly16_t& f) { ml_kem_ntt::scalar::ntt(f); },
+                     [](poly16_t& f) { ml_kem_ntt::scalar::intt(f); },
+                     [](const poly16_t& f, const poly16_t& g, poly16_t& h) { ml_kem_ntt::scalar::polymul(f, g, h); });
+
+  test_int16_kernels([](poly16_t& f) { ml_kem_ntt::ntt(f); },
+                     [](poly16_t& f) { ml_kem_ntt::intt(f); },
+                     [](const poly16_t& f, const poly16_t& g, poly16_t& h) { ml_kem_ntt::polymul(f, g, h); });
+
+#if ML_KEM_X86_SIMD
+  if (ml_kem_cpu::has_avx2()) {
+    test_int16_kernels([](poly16_t& f) { ml_kem_ntt::avx2::ntt(std::span(f)); },
+                       [](poly16_t& f) { ml_kem_ntt::avx2::intt(std::span(f)); },
+                       [](const poly16_t& f, const poly16_t& g, poly16_t& h) { ml_kem_ntt::avx2::polymul(std::span(f), std::span(g), std::span(h)); });
+  }
+  if (ml_kem_cpu::has_avx512()) {
+    test_int16_kernels([](poly16_t& f) { ml_kem_ntt::avx512::ntt(std::span(f)); },
+                       [](poly16_t& f) { ml_kem_ntt::avx512::intt(std::span(f)); },
+                       [](const poly16_t& f, const poly16_t& g, poly16_t& h) { ml_kem_ntt::avx512::polymul(std::span(f), std::span(g), std::span(h)); });
+  }
+#endif
+}
+
+// Ensure that fused multiply-accumulate kernels, with and without Karatsuba base case multiplication or multiplication cache,
+// compute same sum of products of polynomials in NTT domain, as the `zq_t` reference implementation does, for each dimension used
+// by ML-KEM.
+TEST(ML_KEM, PolymulAccMatchesScalarReference)
+{
+  test_polymul_acc<1>();
+  test_polymul_acc<2>();
+  test_polymul_acc<3>();
+  test_polymul_acc<4>();
+}
+
+#if ML_KEM_X86_SIMD
+// Same as above, but explicitly exercising the AVX2 backend, if executing CPU supports it.
+TEST(ML_KEM, NTTAVX2MatchesScalarReference)
+{
+  if (!ml_kem_cpu::has_avx2()) {
+    GTEST_SKIP() << "AVX2 is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_COUNT = 1UL << 12;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    const auto f = random_poly(csprng);
+    const auto g = random_poly(csprng);
+
+    auto f_ntt_ref = f;
+    auto f_ntt = f;
+    ml_kem_ntt::scalar::ntt(f_ntt_ref);
+    ml_kem_ntt::avx2::ntt(f_ntt);
+    EXPECT_EQ(f_ntt, f_ntt_ref);
+
+    auto f_intt_ref = f;
+    auto f_intt = f;
+    ml_kem_ntt::scalar::intt(f_intt_ref);
+    ml_kem_ntt::avx2::intt(f_intt);
+    EXPECT_EQ(f_intt, f_intt_ref);
+
+    poly_t h_ref{};
+    poly_t h{};
+    ml_kem_ntt::scalar::polymul(f, g, h_ref);
+    ml_kem_ntt::avx2::polymul(f, g, h);
+    EXPECT_EQ(h, h_ref);
+  }
+}
+
+// Same as above, but explicitly exercising the AVX-512 backend, if executing CPU supports it.
+TEST(ML_KEM, NTTAVX512MatchesScalarReference)
+{
+  if (!ml_kem_cpu::has_avx512()) {
+    GTEST_SKIP() << "AVX-512 is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_COUNT = 1UL << 12;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    const auto f = random_poly(csprng);
+    const auto g = random_poly(csprng);
+
+    auto f_ntt_ref = f;
+    auto f_ntt = f;
+    ml_kem_ntt::scalar::ntt(f_ntt_ref);
+    ml_kem_ntt::avx512::ntt(f_ntt);
+    EXPECT_EQ(f_ntt, f_ntt_ref);
+
+    auto f_intt_ref = f;
+    auto f_intt = f;
+    ml_kem_ntt::scalar::intt(f_intt_ref);
+    ml_kem_ntt::avx512::intt(f_intt);
+    EXPECT_EQ(f_intt, f_intt_ref);
+
+    poly_t h_ref{};
+    poly_t h{};
+    ml_kem_ntt::scalar::polymul(f, g, h_ref);
+    ml_kem_ntt::avx512::polymul(f, g, h);
+    EXPECT_EQ(h, h_ref);
+  }
+}
+#endif
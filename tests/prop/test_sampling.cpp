@@ -0,0 +1,508 @@
+#include "ml_kem/internals/keccak/shake_xn.hpp"
+#include "ml_kem/internals/math/field.hpp"
+#include "ml_kem/internals/math/montgomery.hpp"
+#include "ml_kem/internals/poly/poly_vec.hpp"
+#include "ml_kem/internals/poly/sampling.hpp"
+#include "randomshake/randomshake.hpp"
+#include "sha3/sha3_256.hpp"
+#include "sha3/sha3_512.hpp"
+#include "sha3/shake128.hpp"
+#include "sha3/shake256.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace {
+
+// Absorbs `lanes` -many random messages of length `mlen` into a multi-lane XOF and squeezes `olen` bytes out of each lane, in
+// chunks of varying size, ensuring that each lane produces same output as the single-lane XOF does, for respective message.
+template<typename xof_xn_t, typename xof_t, size_t lanes>
+void
+test_shake_xn(randomshake::randomshake_t<>& csprng, const size_t mlen, const size_t olen)
+{
+  std::array<std::vector<uint8_t>, lanes> msgs{};
+  std::array<std::vector<uint8_t>, lanes> outs{};
+  std::array<std::span<const uint8_t>, lanes> msg_spans{};
+
+  for (size_t j = 0; j < lanes; j++) {
+    msgs[j].resize(mlen);
+    outs[j].resize(olen);
+
+    csprng.generate(msgs[j]);
+    msg_spans[j] = msgs[j];
+  }
+
+  xof_xn_t hasher_xn;
+  hasher_xn.absorb(msg_spans);
+  hasher_xn.finalize();
+
+  size_t off = 0;
+  size_t chunk = 1;
+  while (off < olen) {
+    const size_t len = std::min(chunk, olen - off);
+
+    std::array<std::span<uint8_t>, lanes> out_spans{};
+    for (size_t j = 0; j < lanes; j++) {
+      out_spans[j] = std::span(outs[j]).subspan(off, len);
+    }
+
+    hasher_xn.squeeze(out_spans);
+
+    off += len;
+    chunk = (chunk * 3) + 1;
+  }
+
+  for (size_t j = 0; j < lanes; j++) {
+    std::vector<uint8_t> expected(olen);
+
+    xof_t hasher;
+    hasher.absorb(msgs[j]);
+    hasher.finalize();
+    hasher.squeeze(expected);
+
+    EXPECT_EQ(outs[j], expected);
+  }
+}
+
+template<size_t lanes, size_t k, bool transpose>
+void
+test_generate_matrix_xn(std::span<const uint8_t, 32> rho)
+{
+  std::vector<int16_t> mat(k * k * ml_kem_ntt::N);
+  std::vector<int16_t> expected(k * k * ml_kem_ntt::N);
+
+  ml_kem_utils::generate_matrix_xn<lanes, k, transpose>(std::span<int16_t, k * k * ml_kem_ntt::N>(mat), rho);
+
+  std::array<uint8_t, 34> xof_in{};
+  std::copy(rho.begin(), rho.end(), xof_in.begin());
+
+  for (size_t i = 0; i < k; i++) {
+    for (size_t j = 0; j < k; j++) {
+      xof_in[32] = static_cast<uint8_t>(transpose ? i : j);
+      xof_in[33] = static_cast<uint8_t>(transpose ? j : i);
+
+      shake128::shake128_t hasher;
+      hasher.absorb(xof_in);
+      hasher.finalize();
+
+      ml_kem_utils::sample_ntt(hasher, std::span(expected).subspan((i * k + j) * ml_kem_ntt::N).template first<ml_kem_ntt::N>());
+    }
+  }
+
+  EXPECT_EQ(mat, expected);
+}
+
+// Test that multiplying public matrix A ( or its transpose ), while expanding it one row at a time, produces same result as expanding
+// the whole matrix first and then multiplying it, and that each row is sampled same as `generate_matrix` samples it.
+template<size_t k, bool transpose>
+void
+test_expand_matrix_multiply(std::span<const uint8_t, 32> rho, randomshake::randomshake_t<>& csprng)
+{
+  std::vector<int16_t> mat(k * k * ml_kem_ntt::N);
+  std::vector<int16_t> row(k * ml_kem_ntt::N);
+  std::vector<int16_t> vec(k * ml_kem_ntt::N);
+  std::vector<int16_t> vec_cache(k * ml_kem_ntt::N / 2);
+  std::vector<int16_t> res(k * ml_kem_ntt::N);
+  std::vector<int16_t> expected(k * ml_kem_ntt::N);
+
+  using mat_t = std::span<int16_t, k * k * ml_kem_ntt::N>;
+  using vec_t = std::span<int16_t, k * ml_kem_ntt::N>;
+  using cache_t = std::span<int16_t, k * ml_kem_ntt::N / 2>;
+
+  for (auto& coeff : vec) {
+    coeff = static_cast<int16_t>(ml_kem_field::zq_t::random(csprng).raw());
+  }
+  ml_kem_utils::poly_vec_mulcache<k>(vec_t(vec), cache_t(vec_cache));
+
+  ml_kem_utils::generate_matrix<k, transpose>(mat_t(mat), rho);
+  ml_kem_utils::matrix_multiply<k, k, k, 1>(mat_t(mat), vec_t(vec), cache_t(vec_cache), vec_t(expected));
+  ml_kem_utils::expand_matrix_multiply<k, transpose>(rho, vec_t(vec), cache_t(vec_cache), vec_t(res), vec_t(row));
+
+  EXPECT_EQ(res, expected);
+
+  for (size_t i = 0; i < k; i++) {
+    ml_kem_utils::generate_matrix_row<k, transpose>(vec_t(row), rho, i);
+    EXPECT_TRUE(std::equal(row.begin(), row.end(), mat.begin() + static_cast<ptrdiff_t>(i * k * ml_kem_ntt::N)));
+  }
+}
+
+// Computes expected noise polynomial, from Bη, for given PRF nonce, using single-lane SHAKE256.
+template<size_t eta>
+void
+expected_noise_poly(std::span<const uint8_t, 32> sigma, const uint8_t nonce, std::span<int16_t, ml_kem_ntt::N> poly)
+{
+  std::array<uint8_t, 33> prf_in{};
+  std::array<uint8_t, 64 * eta> prf_out{};
+  std::copy(sigma.begin(), sigma.end(), prf_in.begin());
+  prf_in[32] = nonce;
+
+  shake256::shake256_t hasher;
+  hasher.absorb(prf_in);
+  hasher.finalize();
+  hasher.squeeze(prf_out);
+
+  ml_kem_utils::sample_poly_cbd<eta>(prf_out, poly);
+}
+
+template<size_t lanes, size_t k1, size_t eta1, size_t k2, size_t eta2>
+void
+test_generate_vectors_xn(std::span<const uint8_t, 32> sigma, const uint8_t nonce)
+{
+  std::vector<int16_t> vec1(k1 * ml_kem_ntt::N);
+  std::vector<int16_t> vec2(k2 * ml_kem_ntt::N);
+  std::vector<int16_t> expected1(k1 * ml_kem_ntt::N);
+  std::vector<int16_t> expected2(k2 * ml_kem_ntt::N);
+
+  ml_kem_utils::generate_vectors_xn<lanes, k1, eta1, k2, eta2>(
+    std::span<int16_t, k1 * ml_kem_ntt::N>(vec1), std::span<int16_t, k2 * ml_kem_ntt::N>(vec2), sigma, nonce);
+
+  for (size_t i = 0; i < k1; i++) {
+    expected_noise_poly<eta1>(sigma, static_cast<uint8_t>(nonce + i), std::span(expected1).subspan(i * ml_kem_ntt::N).template first<ml_kem_ntt::N>());
+  }
+  for (size_t i = 0; i < k2; i++) {
+    expected_noise_poly<eta2>(sigma, static_cast<uint8_t>(nonce + k1 + i), std::span(expected2).subspan(i * ml_kem_ntt::N).template first<ml_kem_ntt::N>());
+  }
+
+  EXPECT_EQ(vec1, expected1);
+  EXPECT_EQ(vec2, expected2);
+}
+
+// Samples a polynomial in NTT representation, from XOF output of given seed, using a fixed budget of `blocks` -many SHAKE128 blocks,
+// ensuring that it matches block by block sampling, while reported statistics match the candidates which block by block sampling
+// examines.
+template<size_t blocks>
+void
+test_sample_ntt_budget(std::span<const uint8_t> seed)
+{
+  constexpr size_t rate = shake128::RATE / std::numeric_limits<uint8_t>::digits;
+
+  std::array<int16_t, ml_kem_ntt::N> expected{};
+  std::array<int16_t, ml_kem_ntt::N> computed{};
+
+  shake128::shake128_t hasher_ref;
+  hasher_ref.absorb(seed);
+  hasher_ref.finalize();
+
+  size_t expected_rejected = 0;
+  size_t expected_blocks = 0;
+  size_t coeff_idx = 0;
+  std::array<uint8_t, rate> buf{};
+
+  while (coeff_idx < ml_kem_ntt::N) {
+    hasher_ref.squeeze(buf);
+    expected_blocks++;
+
+    for (size_t off = 0; (off < buf.size()) && (coeff_idx < ml_kem_ntt::N); off += 3) {
+      const std::array<uint16_t, 2> d{ static_cast<uint16_t>(((buf[off + 1] & 0x0f) << 8) | buf[off + 0]),
+                                       static_cast<uint16_t>((buf[off + 2] << 4) | (buf[off + 1] >> 4)) };
+
+      for (size_t l = 0; (l < d.size()) && (coeff_idx < ml_kem_ntt::N); l++) {
+        if (d[l] < ml_kem_field::Q) {
+          expected[coeff_idx++] = static_cast<int16_t>(d[l]);
+        } else {
+          expected_rejected++;
+        }
+      }
+    }
+  }
+
+  shake128::shake128_t hasher;
+  hasher.absorb(seed);
+  hasher.finalize();
+
+  const auto stats = ml_kem_utils::sample_ntt<blocks>(hasher, computed);
+
+  EXPECT_EQ(computed, expected);
+  EXPECT_EQ(stats.rejected, expected_rejected);
+  EXPECT_EQ(stats.extra_blocks, (expected_blocks > blocks) ? (expected_blocks - blocks) : 0);
+}
+
+// Given a multi-lane SHA3 instance and its single-lane counterpart, this routine checks that each lane's digest matches, for messages of
+// given length.
+template<typename hash_xn_t, typename hash_t, size_t lanes, size_t dlen>
+void
+test_sha3_xn(randomshake::randomshake_t<>& csprng, const size_t mlen)
+{
+  std::array<std::vector<uint8_t>, lanes> msgs{};
+  std::array<std::array<uint8_t, dlen>, lanes> digests{};
+  std::array<std::span<const uint8_t>, lanes> msg_spans{};
+  std::array<std::span<uint8_t>, lanes> digest_spans{};
+
+  for (size_t j = 0; j < lanes; j++) {
+    msgs[j].resize(mlen);
+    csprng.generate(msgs[j]);
+
+    msg_spans[j] = msgs[j];
+    digest_spans[j] = digests[j];
+  }
+
+  hash_xn_t hasher_xn;
+  hasher_xn.absorb(msg_spans);
+  hasher_xn.finalize();
+  hasher_xn.squeeze(digest_spans);
+
+  for (size_t j = 0; j < lanes; j++) {
+    std::array<uint8_t, dlen> expected{};
+
+    hash_t hasher;
+    hasher.absorb(msgs[j]);
+    hasher.finalize();
+    hasher.digest(expected);
+
+    EXPECT_EQ(digests[j], expected);
+  }
+}
+
+template<size_t lanes>
+void
+test_generate_noise_xn(std::span<const uint8_t, 32> sigma, const uint8_t nonce)
+{
+  // Noise vectors, as sampled by K-PKE key generation ( s, e ) and encryption ( r, e1 || e2 ), for each ML-KEM parameter set.
+  test_generate_vectors_xn<lanes, 2, 3, 2, 3>(sigma, nonce);
+  test_generate_vectors_xn<lanes, 2, 3, 3, 2>(sigma, nonce);
+  test_generate_vectors_xn<lanes, 3, 2, 3, 2>(sigma, nonce);
+  test_generate_vectors_xn<lanes, 3, 2, 4, 2>(sigma, nonce);
+  test_generate_vectors_xn<lanes, 4, 2, 4, 2>(sigma, nonce);
+  test_generate_vectors_xn<lanes, 4, 2, 5, 2>(sigma, nonce);
+}
+
+}
+
+// Ensure that each lane of 4-way and 8-way SHAKE128 and SHAKE256 ( and of a 3-way one, which always uses the portable interleaved
+// permutation ) produces same output as the single-lane XOF does, for messages and outputs of
+// lengths, which cover partial and multi-block absorption and squeezing.
+TEST(ML_KEM, MultiLaneSHAKEMatchesSingleLane)
+{
+  randomshake::randomshake_t csprng{};
+
+  for (size_t mlen = 0; mlen <= 2 * 168 + 1; mlen += 13) {
+    for (size_t olen : { 0UL, 1UL, 33UL, 136UL, 168UL, 504UL, 1001UL }) {
+      test_shake_xn<ml_kem_keccak::shake128_x4_t, shake128::shake128_t, 4>(csprng, mlen, olen);
+      test_shake_xn<ml_kem_keccak::shake256_x4_t, shake256::shake256_t, 4>(csprng, mlen, olen);
+      test_shake_xn<ml_kem_keccak::shake128_x8_t, shake128::shake128_t, 8>(csprng, mlen, olen);
+      test_shake_xn<ml_kem_keccak::shake256_x8_t, shake256::shake256_t, 8>(csprng, mlen, olen);
+      test_shake_xn<ml_kem_keccak::shake_xn_t<3, 168>, shake128::shake128_t, 3>(csprng, mlen, olen);
+    }
+  }
+}
+
+// Ensure that each lane of 4-way and 8-way SHA3-256 and SHA3-512 produces same digest as the single-lane hash function does, for messages
+// of lengths, which cover partial and multi-block absorption.
+TEST(ML_KEM, MultiLaneSHA3MatchesSingleLane)
+{
+  randomshake::randomshake_t csprng{};
+
+  for (size_t mlen = 0; mlen <= 3 * 136 + 1; mlen += 17) {
+    test_sha3_xn<ml_kem_keccak::sha3_256_x4_t, sha3_256::sha3_256_t, 4, sha3_256::DIGEST_LEN>(csprng, mlen);
+    test_sha3_xn<ml_kem_keccak::sha3_512_x4_t, sha3_512::sha3_512_t, 4, sha3_512::DIGEST_LEN>(csprng, mlen);
+    test_sha3_xn<ml_kem_keccak::sha3_256_x8_t, sha3_256::sha3_256_t, 8, sha3_256::DIGEST_LEN>(csprng, mlen);
+    test_sha3_xn<ml_kem_keccak::sha3_512_x8_t, sha3_512::sha3_512_t, 8, sha3_512::DIGEST_LEN>(csprng, mlen);
+  }
+}
+
+// Ensure that sampling matrix A using 4-way and 8-way SHAKE, and noise vectors using 4-way and 8-way SHAKE256, produces same polynomials as sequential sampling does.
+TEST(ML_KEM, MultiLaneSamplingMatchesSequential)
+{
+  constexpr size_t ITERATION_COUNT = 16;
+
+  randomshake::randomshake_t csprng{};
+  std::array<uint8_t, 32> seed{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed);
+
+    test_generate_matrix_xn<4, 2, false>(seed);
+    test_generate_matrix_xn<4, 2, true>(seed);
+    test_generate_matrix_xn<4, 3, false>(seed);
+    test_generate_matrix_xn<4, 3, true>(seed);
+    test_generate_matrix_xn<4, 4, false>(seed);
+    test_generate_matrix_xn<4, 4, true>(seed);
+
+    test_generate_matrix_xn<8, 2, false>(seed);
+    test_generate_matrix_xn<8, 2, true>(seed);
+    test_generate_matrix_xn<8, 3, false>(seed);
+    test_generate_matrix_xn<8, 3, true>(seed);
+    test_generate_matrix_xn<8, 4, false>(seed);
+    test_generate_matrix_xn<8, 4, true>(seed);
+
+    const auto nonce = static_cast<uint8_t>(i * 7);
+
+    test_generate_noise_xn<4>(seed, nonce);
+    test_generate_noise_xn<8>(seed, nonce);
+  }
+}
+
+// Ensure that sampling a polynomial in NTT representation from a fixed budget of SHAKE128 blocks produces same polynomial as block by
+// block sampling does, both when the budget suffices and when the slow path has to squeeze more, while reporting rejection counts.
+TEST(ML_KEM, FixedBudgetUniformSamplingMatchesBlockByBlock)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 8;
+
+  randomshake::randomshake_t csprng{};
+  std::array<uint8_t, 34> seed{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed);
+
+    test_sample_ntt_budget<1>(seed);
+    test_sample_ntt_budget<2>(seed);
+    test_sample_ntt_budget<3>(seed);
+    test_sample_ntt_budget<ml_kem_utils::REJ_UNIFORM_BLOCKS>(seed);
+  }
+}
+
+// Ensure that sampling polynomials with signed 16 -bit coefficients produces same elements of Z_q, as sampling `zq_t` polynomials
+// does, while uniform sampling keeps them canonical and CBD sampling keeps them ∈ [-η, η].
+TEST(ML_KEM, Int16SamplingMatchesReference)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 10;
+
+  randomshake::randomshake_t csprng{};
+  std::array<uint8_t, 64 * 3> prf{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(prf);
+
+    std::array<ml_kem_field::zq_t, ml_kem_ntt::N> ref{};
+    std::array<int16_t, ml_kem_ntt::N> poly{};
+
+    shake128::shake128_t hasher_ref;
+    hasher_ref.absorb(prf);
+    hasher_ref.finalize();
+    ml_kem_utils::sample_ntt(hasher_ref, ref);
+
+    shake128::shake128_t hasher;
+    hasher.absorb(prf);
+    hasher.finalize();
+    ml_kem_utils::sample_ntt(hasher, poly);
+
+    for (size_t j = 0; j < ml_kem_ntt::N; j++) {
+      EXPECT_EQ(static_cast<uint32_t>(poly[j]), ref[j].raw());
+    }
+
+    ml_kem_utils::sample_poly_cbd<2>(std::span(prf).first<64 * 2>(), ref);
+    ml_kem_utils::sample_poly_cbd<2>(std::span(prf).first<64 * 2>(), poly);
+
+    for (size_t j = 0; j < ml_kem_ntt::N; j++) {
+      EXPECT_LE(std::abs(poly[j]), 2);
+      EXPECT_EQ(ml_kem_field::zq_t(static_cast<uint32_t>(ml_kem_field::canonicalize(poly[j]))), ref[j]);
+    }
+
+    ml_kem_utils::sample_poly_cbd<3>(prf, ref);
+    ml_kem_utils::sample_poly_cbd<3>(prf, poly);
+
+    for (size_t j = 0; j < ml_kem_ntt::N; j++) {
+      EXPECT_LE(std::abs(poly[j]), 3);
+      EXPECT_EQ(ml_kem_field::zq_t(static_cast<uint32_t>(ml_kem_field::canonicalize(poly[j]))), ref[j]);
+    }
+  }
+}
+
+#if ML_KEM_X86_SIMD
+// Ensure that vectorized rejection sampling accepts exactly same candidates, in same order, as scalar parsing does, for XOF outputs
+// of varying length, for varying number of already sampled coefficients and for varying rate of rejection.
+TEST(ML_KEM, RejectionSamplingAVX2MatchesScalar)
+{
+  if (!ml_kem_cpu::has_avx2()) {
+    GTEST_SKIP() << "AVX2 is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_COUNT = 1UL << 6;
+
+  randomshake::randomshake_t csprng{};
+  std::vector<uint8_t> buf{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    for (size_t blen : { 0UL, 24UL, 30UL, 168UL, 3 * 168UL, 999UL }) {
+      for (size_t coeff_idx : { 0UL, 100UL, 240UL, 241UL, 255UL }) {
+        buf.resize(blen);
+        csprng.generate(buf);
+
+        // Setting some of the upper bits of each byte makes more candidates get rejected.
+        const auto bias = static_cast<uint8_t>((i % 4) * 0x50);
+        std::ranges::for_each(buf, [&](uint8_t& b) { b |= bias; });
+
+        std::array<int16_t, ml_kem_ntt::N> expected{};
+        std::array<int16_t, ml_kem_ntt::N> computed{};
+
+        size_t expected_rejected = 0;
+        size_t computed_rejected = 0;
+
+        const size_t expected_idx = ml_kem_utils::parse_ntt_coeffs(buf, std::span(expected), coeff_idx, expected_rejected);
+        const size_t computed_idx = ml_kem_utils::parse_ntt_coeffs_avx2(buf, computed, coeff_idx, computed_rejected);
+
+        EXPECT_EQ(computed_idx, expected_idx);
+        EXPECT_EQ(computed_rejected, expected_rejected);
+        EXPECT_TRUE(std::equal(computed.begin(), computed.begin() + static_cast<std::ptrdiff_t>(expected_idx), expected.begin()));
+      }
+    }
+  }
+}
+#endif
+
+#if ML_KEM_X86_SIMD
+// Ensure that vectorized sampling from centered binomial distribution produces same coefficients as the portable `zq_t` sampler
+// does, in their centered representation, for both η = 2 and η = 3.
+TEST(ML_KEM, CBDSamplingAVX2MatchesScalar)
+{
+  if (!ml_kem_cpu::has_avx2()) {
+    GTEST_SKIP() << "AVX2 is not supported by this CPU";
+  }
+
+  constexpr size_t ITERATION_COUNT = 1UL << 10;
+
+  randomshake::randomshake_t csprng{};
+  std::array<uint8_t, 64 * 3> prf{};
+
+  // Maps an element of Z_q, which is known to be ∈ [-3, 3], to its centered representation.
+  const auto centered = [](const ml_kem_field::zq_t v) {
+    const auto raw = static_cast<int32_t>(v.raw());
+    return static_cast<int16_t>((raw > static_cast<int32_t>(ml_kem_field::Q / 2)) ? (raw - static_cast<int32_t>(ml_kem_field::Q)) : raw);
+  };
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(prf);
+
+    std::array<ml_kem_field::zq_t, ml_kem_ntt::N> ref{};
+    std::array<int16_t, ml_kem_ntt::N> expected{};
+    std::array<int16_t, ml_kem_ntt::N> computed{};
+
+    ml_kem_utils::sample_poly_cbd<2>(std::span(prf).first<64 * 2>(), ref);
+    std::ranges::transform(ref, expected.begin(), centered);
+    ml_kem_utils::avx2::cbd2(std::span(prf).first<64 * 2>(), computed);
+
+    EXPECT_EQ(computed, expected);
+
+    ml_kem_utils::sample_poly_cbd<3>(prf, ref);
+    std::ranges::transform(ref, expected.begin(), centered);
+    ml_kem_utils::avx2::cbd3(prf, computed);
+
+    EXPECT_EQ(computed, expected);
+  }
+}
+#endif
+
+TEST(ML_KEM, StreamedMatrixMultiplicationMatchesMaterialized)
+{
+  constexpr size_t ITERATION_COUNT = 16;
+
+  randomshake::randomshake_t csprng{};
+  std::array<uint8_t, 32> seed{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    csprng.generate(seed);
+
+    test_expand_matrix_multiply<2, false>(seed, csprng);
+    test_expand_matrix_multiply<2, true>(seed, csprng);
+    test_expand_matrix_multiply<3, false>(seed, csprng);
+    test_expand_matrix_multiply<3, true>(seed, csprng);
+    test_expand_matrix_multiply<4, false>(seed, csprng);
+    test_expand_matrix_multiply<4, true>(seed, csprng);
+  }
+}
@@ -2,6 +2,7 @@
 #include "ml_kem/internals/poly/ntt.hpp"
 #include "ml_kem/internals/poly/serialize.hpp"
 #include "randomshake/randomshake.hpp"
+#include <array>
 #include <cstddef>
 #include <cstdint>
 #include <gtest/gtest.h>
@@ -42,6 +43,89 @@ test_serialize_deserialize()
   }
 }
 
+// Ensure that serializing a polynomial with signed 16 -bit coefficients, which may be arbitrary, produces same bytes as serializing
+// its fully reduced `zq_t` form does, while deserializing arbitrary bytes produces same coefficients in both forms. This exercises the
+// vectorized kernels, when executing CPU supports them.
+template<size_t l>
+void
+test_int16_serialization(randomshake::randomshake_t<>& csprng)
+{
+  constexpr size_t blen = 32 * l;
+
+  std::array<int16_t, ml_kem_ntt::N> poly{};
+  std::array<ml_kem_field::zq_t, ml_kem_ntt::N> ref{};
+  std::array<uint8_t, blen> bytes{};
+  std::array<uint8_t, blen> expected_bytes{};
+
+  csprng.generate(std::span(reinterpret_cast<uint8_t*>(poly.data()), sizeof(poly))); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+  for (size_t i = 0; i < ml_kem_ntt::N; i++) {
+    ref[i] = ml_kem_field::zq_t(static_cast<uint16_t>(ml_kem_field::to_canonical(poly[i])));
+  }
+
+  ml_kem_utils::encode<l>(std::span<const int16_t, ml_kem_ntt::N>(poly), bytes);
+  ml_kem_utils::encode<l>(std::span<const ml_kem_field::zq_t, ml_kem_ntt::N>(ref), expected_bytes);
+
+  EXPECT_EQ(bytes, expected_bytes);
+
+  csprng.generate(bytes);
+
+  ml_kem_utils::decode<l>(std::span<const uint8_t, blen>(bytes), poly);
+  ml_kem_utils::decode<l>(std::span<const uint8_t, blen>(bytes), ref);
+
+  for (size_t i = 0; i < ml_kem_ntt::N; i++) {
+    EXPECT_EQ(static_cast<uint32_t>(poly[i]), ref[i].raw());
+  }
+}
+
+// Test that `decode_checked<12>` decodes same coefficients as `decode<12>` does, while flagging the input iff re-encoding decoded
+// coefficients doesn't reproduce it, i.e. the modulus check described in section 7.2 of ML-KEM specification fails.
+void
+test_checked_decoding(randomshake::randomshake_t<>& csprng)
+{
+  constexpr size_t blen = 32 * 12;
+
+  std::array<int16_t, ml_kem_ntt::N> poly{};
+  std::array<int16_t, ml_kem_ntt::N> expected_poly{};
+  std::array<uint8_t, blen> bytes{};
+  std::array<uint8_t, blen> reencoded{};
+
+  // Well-formed encoding of a polynomial with canonical coefficients, with or without a single non-canonical coefficient spliced in.
+  for (const bool inject : { false, true }) {
+    for (auto& coeff : poly) {
+      coeff = static_cast<int16_t>(ml_kem_field::zq_t::random(csprng).raw());
+    }
+
+    if (inject) {
+      std::array<uint8_t, 2> rnd{};
+      csprng.generate(rnd);
+
+      poly[rnd[0]] = static_cast<int16_t>(ml_kem_field::Q + (rnd[1] % ((1U << 12) - ml_kem_field::Q)));
+    }
+
+    // Packed by hand, as `encode<12>` would fully reduce the non-canonical coefficient.
+    for (size_t i = 0; i < ml_kem_ntt::N; i += 2) {
+      const auto t0 = static_cast<uint32_t>(poly[i]);
+      const auto t1 = static_cast<uint32_t>(poly[i + 1]);
+
+      bytes[((i / 2) * 3) + 0] = static_cast<uint8_t>(t0);
+      bytes[((i / 2) * 3) + 1] = static_cast<uint8_t>((t0 >> 8) | (t1 << 4));
+      bytes[((i / 2) * 3) + 2] = static_cast<uint8_t>(t1 >> 4);
+    }
+
+    EXPECT_EQ(ml_kem_utils::decode_checked<12>(bytes, poly), inject ? -1U : 0U);
+  }
+
+  // Random bytes, where most of the 12 -bit coefficients are expected to be ≥ q.
+  csprng.generate(bytes);
+
+  const auto non_canonical = ml_kem_utils::decode_checked<12>(bytes, poly);
+  ml_kem_utils::decode<12>(std::span<const uint8_t, blen>(bytes), expected_poly);
+  ml_kem_utils::encode<12>(std::span<const int16_t, ml_kem_ntt::N>(expected_poly), reencoded);
+
+  EXPECT_EQ(poly, expected_poly);
+  EXPECT_EQ(non_canonical, (bytes == reencoded) ? 0U : -1U);
+}
+
 } // namespace
 
 TEST(ML_KEM, PolynomialSerialization)
@@ -53,3 +137,30 @@ TEST(ML_KEM, PolynomialSerialization)
   test_serialize_deserialize<4>();
   test_serialize_deserialize<1>();
 }
+
+TEST(ML_KEM, Int16PolynomialSerializationMatchesReference)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 8;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    test_int16_serialization<12>(csprng);
+    test_int16_serialization<11>(csprng);
+    test_int16_serialization<10>(csprng);
+    test_int16_serialization<5>(csprng);
+    test_int16_serialization<4>(csprng);
+    test_int16_serialization<1>(csprng);
+  }
+}
+
+TEST(ML_KEM, CheckedDecodingMatchesModulusCheck)
+{
+  constexpr size_t ITERATION_COUNT = 1UL << 10;
+
+  randomshake::randomshake_t csprng{};
+
+  for (size_t i = 0; i < ITERATION_COUNT; i++) {
+    test_checked_decoding(csprng);
+  }
+}
@@ -0,0 +1,132 @@
+#include "ml_kem/ml_kem_1024.hpp"
+#include "ml_kem/ml_kem_512.hpp"
+#include "ml_kem/ml_kem_768.hpp"
+#include "randomshake/randomshake.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <memory>
+#include <ucontext.h>
+#include <utility>
+
+static_assert(ML_KEM_LOW_STACK == 1, "Peak stack usage is bounded only in low-stack configuration");
+
+namespace {
+
+// Documented upper bound on peak stack usage of ML-KEM routines, for every parameter set, in low-stack configuration.
+constexpr size_t LOW_STACK_BOUND = 4096;
+
+// Routines are run on a separate stack of this size, which is painted with a known byte pattern, before running the routine. The
+// deepest byte, which no longer holds the pattern, tells how much of the stack was used, as it grows downwards.
+constexpr size_t MEASUREMENT_STACK_SIZE = 64 * 1024;
+constexpr uint8_t PAINT = 0xa5;
+
+ucontext_t caller_ctx{};
+ucontext_t callee_ctx{};
+const std::function<void()>* routine = nullptr;
+
+void
+trampoline()
+{
+  (*routine)();
+}
+
+// Runs given routine on a freshly painted stack, returning number of bytes of it, which were used.
+size_t
+peak_stack_usage(const std::function<void()>& fn)
+{
+  alignas(16) static std::array<uint8_t, MEASUREMENT_STACK_SIZE> stack{};
+  stack.fill(PAINT);
+
+  routine = &fn;
+
+  getcontext(&callee_ctx);
+  callee_ctx.uc_stack.ss_sp = stack.data();
+  callee_ctx.uc_stack.ss_size = stack.size();
+  callee_ctx.uc_link = &caller_ctx;
+  makecontext(&callee_ctx, trampoline, 0);
+  swapcontext(&caller_ctx, &callee_ctx);
+
+  const auto deepest = std::find_if(stack.begin(), stack.end(), [](const uint8_t b) { return b != PAINT; });
+  return static_cast<size_t>(stack.end() - deepest);
+}
+
+// Measures peak stack usage of key generation, encapsulation and decapsulation ( with and without caller-supplied workspace ) and of
+// preparing keys and using them, for given ML-KEM parameter set, asserting that none of them crosses the documented bound.
+template<size_t k, size_t eta1, size_t eta2, size_t du, size_t dv>
+void
+test_peak_stack_usage()
+{
+  std::array<uint8_t, 32> seed_d{};
+  std::array<uint8_t, 32> seed_z{};
+  std::array<uint8_t, 32> seed_m{};
+
+  std::array<uint8_t, ml_kem_utils::get_kem_public_key_len(k)> pubkey{};
+  std::array<uint8_t, ml_kem_utils::get_kem_secret_key_len(k)> seckey{};
+  std::array<uint8_t, ml_kem_utils::get_kem_cipher_text_len(k, du, dv)> cipher{};
+  std::array<uint8_t, 32> shared_secret_sender{};
+  std::array<uint8_t, 32> shared_secret_receiver{};
+
+  auto ws = std::make_unique<ml_kem::workspace_t<k>>();
+  auto prepared_pubkey = std::make_unique<ml_kem::prepared_pubkey_t<k>>();
+  auto prepared_seckey = std::make_unique<ml_kem::prepared_seckey_t<k>>();
+
+  randomshake::randomshake_t csprng{};
+  csprng.generate(seed_d);
+  csprng.generate(seed_z);
+  csprng.generate(seed_m);
+
+  const std::array<std::pair<const char*, std::function<void()>>, 10> routines{ {
+    { "keygen", [&]() { ml_kem::keygen<k, eta1>(seed_d, seed_z, pubkey, seckey); } },
+    { "keygen (workspace)", [&]() { ml_kem::keygen<k, eta1>(seed_d, seed_z, pubkey, seckey, *ws); } },
+    { "encapsulate", [&]() { EXPECT_TRUE((ml_kem::encapsulate<k, eta1, eta2, du, dv>(seed_m, pubkey, cipher, shared_secret_sender))); } },
+    { "encapsulate (workspace)",
+      [&]() { EXPECT_TRUE((ml_kem::encapsulate<k, eta1, eta2, du, dv>(seed_m, pubkey, cipher, shared_secret_sender, *ws))); } },
+    { "decapsulate", [&]() { ml_kem::decapsulate<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret_receiver); } },
+    { "decapsulate (workspace)", [&]() { ml_kem::decapsulate<k, eta1, eta2, du, dv>(seckey, cipher, shared_secret_receiver, *ws); } },
+    { "prepare_pubkey", [&]() { EXPECT_TRUE(ml_kem::prepare_pubkey<k>(pubkey, *prepared_pubkey)); } },
+    { "prepare_seckey", [&]() { EXPECT_TRUE(ml_kem::prepare_seckey<k>(seckey, *prepared_seckey)); } },
+    { "encapsulate (prepared)", [&]() { ml_kem::encapsulate<k, eta1, eta2, du, dv>(seed_m, *prepared_pubkey, cipher, shared_secret_sender); } },
+    { "decapsulate (prepared)", [&]() { ml_kem::decapsulate<k, eta1, eta2, du, dv>(*prepared_seckey, cipher, shared_secret_receiver); } },
+  } };
+
+  for (const auto& [name, fn] : routines) {
+    // Run once on regular stack, s.t. one-time initialization, say of CPU feature detection or of heap allocator, isn't accounted.
+    fn();
+
+    const size_t used = peak_stack_usage(fn);
+    EXPECT_LT(used, LOW_STACK_BOUND) << name << " used " << used << " bytes of stack";
+  }
+
+  EXPECT_EQ(shared_secret_sender, shared_secret_receiver);
+}
+
+}
+
+// Peak stack usage is only meaningful for optimized builds, as unoptimized ones keep every temporary in its own stack slot.
+#if defined(__OPTIMIZE__)
+#define SKIP_UNLESS_OPTIMIZED()
+#else
+#define SKIP_UNLESS_OPTIMIZED() GTEST_SKIP() << "Peak stack usage is bounded only in optimized builds"
+#endif
+
+TEST(ML_KEM, ML_KEM_512_LowStackPeakUsage)
+{
+  SKIP_UNLESS_OPTIMIZED();
+  test_peak_stack_usage<ml_kem_512::k, ml_kem_512::eta1, ml_kem_512::eta2, ml_kem_512::du, ml_kem_512::dv>();
+}
+
+TEST(ML_KEM, ML_KEM_768_LowStackPeakUsage)
+{
+  SKIP_UNLESS_OPTIMIZED();
+  test_peak_stack_usage<ml_kem_768::k, ml_kem_768::eta1, ml_kem_768::eta2, ml_kem_768::du, ml_kem_768::dv>();
+}
+
+TEST(ML_KEM, ML_KEM_1024_LowStackPeakUsage)
+{
+  SKIP_UNLESS_OPTIMIZED();
+  test_peak_stack_usage<ml_kem_1024::k, ml_kem_1024::eta1, ml_kem_1024::eta2, ml_kem_1024::du, ml_kem_1024::dv>();
+}